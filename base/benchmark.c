@@ -1,9 +1,11 @@
+#define _GNU_SOURCE                     // pthread_setaffinity_np, CPU_SET
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <string.h>
+#include <strings.h>
 #include <time.h>
 #include <math.h>
 #include <errno.h>
@@ -11,12 +13,46 @@
 #include <sys/time.h>
 #include <stdbool.h>
 #include <sys/stat.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <sys/statvfs.h>
+#include <sys/resource.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define HAVE_IO_URING 1
+#endif
+#if __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#define HAVE_PERF_EVENTS 1
+#endif
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#include <x86intrin.h>
+#include <cpuid.h>
+#define HAVE_X86_SIMD 1
+#endif
 
 /* Configuration Constants */
 #define DEFAULT_NUM_THREADS 4
 #define DEFAULT_MEMORY_BLOCK_SIZE (100 * 1024 * 1024)  // 100 MB blocks
 #define DEFAULT_FILE_SIZE (10 * 1024 * 1024)           // 10 MB file operations
+#define DEFAULT_IO_BLOCK_SIZE (1024 * 1024)            // Request size of the block-based disk tests
+#define DEFAULT_RANDOM_BLOCK_SIZE 4096                  // Request size of the random disk tests
 #define DEFAULT_TEST_DURATION 20                        // Test duration in seconds
+#define DEFAULT_SLICE_MS 50                             // Continuous-load batch target in ms
+#define BURSTY_PAUSE_US 5000                            // Pause between batches in bursty mode
+#define PEAK_FLOPS_CHAINS 12                            // Independent FMA accumulators per kernel
 #define BILLION 1000000000.0
 
 /* Benchmark Baseline Reference Values (from a reference system) */
@@ -37,11 +73,42 @@
 typedef struct {
     // Raw performance metrics
     double cpu_flops;                  // Floating point operations per second
+    double cpu_peak_flops;             // Peak FLOPS from independent FMA chains
+    double cpu_vector_flops;           // FLOPS workload with vectorized sin/cos/sqrt
+    double cpu_dgemm_flops;            // DGEMM FLOPS for the size currently measured
     double memory_read_bandwidth;      // Memory read bandwidth in MB/s
     double memory_write_bandwidth;     // Memory write bandwidth in MB/s
+    double memory_nt_write_bandwidth;  // Non-temporal (streaming store) write bandwidth in MB/s
+    double memory_touch_bandwidth;     // Strided one-byte-per-128 "touch" rate in MB/s
+    double memory_latency_ns;          // Pointer-chase ns per load for the size measured
+    double sweep_read_bandwidth;       // Cache sweep read MB/s for the size measured
+    double sweep_write_bandwidth;      // Cache sweep write MB/s for the size measured
+    double numa_read_bandwidth;        // NUMA matrix read MB/s for the node pair measured
+    double numa_write_bandwidth;       // NUMA matrix write MB/s for the node pair measured
+    double numa_latency_ns;            // NUMA matrix pointer-chase ns per load
+    double pages_read_bandwidth;       // Page size comparison read MB/s for the backing measured
+    double pages_write_bandwidth;      // Page size comparison write MB/s for the backing measured
+    double pages_latency_ns;           // Page size comparison pointer-chase ns per load
+    double pages_huge_fraction;        // Share of the buffer actually on huge pages
+    double stream_copy_bandwidth;      // STREAM Copy in MB/s (STREAM byte convention)
+    double stream_scale_bandwidth;     // STREAM Scale in MB/s
+    double stream_add_bandwidth;       // STREAM Add in MB/s
+    double stream_triad_bandwidth;     // STREAM Triad in MB/s
     double disk_read_throughput;       // Disk read throughput in MB/s
     double disk_write_throughput;      // Disk write throughput in MB/s
     double disk_seek_iops;             // Disk I/O operations per second (random)
+    double direct_read_throughput;     // O_DIRECT sequential read in MB/s
+    double direct_write_throughput;    // O_DIRECT sequential write (with fdatasync) in MB/s
+    double random_read_iops;           // Random profile reads/s for the profile measured
+    double random_write_iops;          // Random profile writes/s for the profile measured
+    double uring_throughput;           // io_uring MB/s for the workload and queue depth measured
+    double uring_iops;                 // io_uring requests per second for the same cell
+    double commit_rate;                // fdatasync commits per second for the cell measured
+    double mmap_throughput;            // Mapped/syscall file I/O MB/s for the cell measured
+    double io_sweep_iops;              // I/O sweep random reads per second for the cell measured
+    double io_sweep_throughput;        // I/O sweep MB/s for the same cell
+    double mmap_minor_faults;          // Minor page faults of the thread during that cell
+    double mmap_major_faults;          // Major page faults of the thread during that cell
     
     // Performance scores (normalized against reference values)
     int cpu_score;                     // CPU performance score
@@ -50,6 +117,65 @@ typedef struct {
     int overall_score;                 // Combined performance score
 } benchmark_result_t;
 
+/* Load profile: how measurement batches are scheduled */
+typedef enum {
+    LOAD_PROFILE_CONTINUOUS,           // Calibrated batches back to back, no sleeps
+    LOAD_PROFILE_BURSTY                // Fixed batches separated by a short pause
+} load_profile_t;
+
+/* Thread placement policy applied when the workers of a phase are spawned */
+typedef enum {
+    AFFINITY_NONE,                     // Scheduler decides
+    AFFINITY_COMPACT,                  // Fill SMT siblings, then cores, then sockets
+    AFFINITY_SCATTER,                  // Alternate sockets, physical cores before siblings
+    AFFINITY_PHYSICAL,                 // First SMT thread of each physical core only
+    AFFINITY_LIST                      // Explicit CPU list, ascending
+} affinity_policy_t;
+
+const char* const affinity_policy_names[] = {"none", "compact", "scatter", "physical", "list"};
+
+/* Page backing of the large memory-test buffers */
+typedef enum {
+    PAGE_BACKING_DEFAULT,              // Plain anonymous mapping, system THP policy applies
+    PAGE_BACKING_4K,                   // Base pages only (MADV_NOHUGEPAGE)
+    PAGE_BACKING_THP,                  // Transparent huge pages (MADV_HUGEPAGE)
+    PAGE_BACKING_HUGE_2M,              // hugetlbfs 2 MiB pages
+    PAGE_BACKING_HUGE_1G,              // hugetlbfs 1 GiB pages
+    PAGE_BACKING_COUNT
+} page_backing_t;
+
+const char* const page_backing_names[PAGE_BACKING_COUNT] = {"default", "4K", "THP", "2M", "1G"};
+
+/* Per-thread distribution of one metric across the threads of a phase */
+typedef struct {
+    int count;                         // Threads that completed the phase
+    double sum;                        // System-wide (summed) throughput
+    double min;
+    double max;
+    double mean;
+    double stddev;                     // Population standard deviation
+} thread_stats_t;
+
+/* Reduction of every raw metric in benchmark_result_t */
+typedef struct {
+    thread_stats_t cpu_flops;
+    thread_stats_t cpu_peak_flops;
+    thread_stats_t cpu_vector_flops;
+    thread_stats_t memory_read_bandwidth;
+    thread_stats_t memory_write_bandwidth;
+    thread_stats_t memory_nt_write_bandwidth;
+    thread_stats_t memory_touch_bandwidth;
+    thread_stats_t stream_copy_bandwidth;
+    thread_stats_t stream_scale_bandwidth;
+    thread_stats_t stream_add_bandwidth;
+    thread_stats_t stream_triad_bandwidth;
+    thread_stats_t disk_read_throughput;
+    thread_stats_t disk_write_throughput;
+    thread_stats_t disk_seek_iops;
+    thread_stats_t direct_read_throughput;
+    thread_stats_t direct_write_throughput;
+} thread_stats_result_t;
+
 /* Global Variables */
 volatile bool running = true;
 pthread_mutex_t log_mutex = PTHREAD_MUTEX_INITIALIZER;
@@ -57,9 +183,47 @@ pthread_mutex_t results_mutex = PTHREAD_MUTEX_INITIALIZER;
 int num_threads = DEFAULT_NUM_THREADS;
 size_t memory_block_size = DEFAULT_MEMORY_BLOCK_SIZE;
 size_t file_size = DEFAULT_FILE_SIZE;
+size_t io_block_size = DEFAULT_IO_BLOCK_SIZE;
+size_t random_block_size = DEFAULT_RANDOM_BLOCK_SIZE;
+size_t random_file_size = 0;           // Per-thread random I/O file, 0 = automatic
+int random_read_percent = 70;          // Share of reads in the mixed random profile
+int random_sync_mode = 0;              // sync_mode_t of random writes
+long long random_sync_every = 1;       // Writes per fdatasync with SYNC_FDATASYNC
 int duration = DEFAULT_TEST_DURATION;
 benchmark_result_t global_results = {0};
+thread_stats_result_t global_thread_stats = {0};
 bool verbose_output = false;           // Detailed logging control
+load_profile_t load_profile = LOAD_PROFILE_CONTINUOUS;
+int slice_ms = DEFAULT_SLICE_MS;
+affinity_policy_t affinity_policy = AFFINITY_NONE;
+const char* affinity_cpu_list = NULL;  // CPU list for AFFINITY_LIST
+bool run_peak_flops = false;           // Extended test: vectorized peak FLOPS
+bool run_vector_math = false;          // Extended test: vectorized transcendental kernel
+double vector_math_max_ulp = 0.0;      // Verified max error of vector sin/cos vs libm
+double vector_math_checksum_diff = 0.0; // Relative checksum difference vs scalar loop
+bool vector_math_verified = false;
+bool run_dgemm = false;                // Extended test: blocked DGEMM size sweep
+bool run_stream = false;               // Extended test: STREAM memory kernels
+bool stream_verified = true;           // Every STREAM thread's arrays passed validation
+bool run_latency = false;              // Extended test: pointer-chase latency sweep
+bool run_cache_sweep = false;          // Extended test: bandwidth vs. buffer size sweep
+bool run_numa = false;                 // Extended test: node-to-node matrix, NUMA placement
+bool run_direct_io = false;            // Extended test: O_DIRECT sequential disk throughput
+bool run_uring = false;                // Extended test: io_uring queue depth matrix
+bool uring_sqpoll = false;             // io_uring: kernel-side submission polling
+bool uring_fixed = false;              // io_uring: registered buffers and files
+bool run_page_sizes = false;           // Extended test: bandwidth/latency per page backing
+bool run_commit = false;               // Extended test: fdatasync commit latency
+bool run_mmap = false;                 // Extended test: memory-mapped vs. read()/pread() file I/O
+bool run_io_sweep = false;             // Extended test: queue depth x block size per I/O engine
+bool run_perf = false;                 // Per-thread hardware counters around every phase
+int num_trials = 1;                    // Trials per scored phase, 1 = single run
+int trial_warmup = 1;                  // Discarded runs before the trials
+int trial_max = 0;                     // Auto-extension limit, 0 = 3x num_trials
+double trial_cv_target = 2.0;          // Extend until every metric's CV (%) is below
+int commit_group_size = 8;             // Records per fdatasync in the group-commit variant
+page_backing_t memory_page_backing = PAGE_BACKING_DEFAULT;  // Requested for the memory phase
+page_backing_t memory_page_backing_used = PAGE_BACKING_DEFAULT;  // What the kernel provided
 
 /* Configuration structure */
 typedef struct {
@@ -67,12 +231,232 @@ typedef struct {
     int duration;
     char* temp_filename;
     void* thread_buffer;               // Thread-specific buffer
+    bool completed;                    // Set once thread_results is valid
     benchmark_result_t thread_results;
 } thread_args_t;
 
-/* Timespec difference in seconds */
-double timespec_diff(struct timespec start, struct timespec end) {
-    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / BILLION;
+/* Counter group of the calling benchmark thread, -1 without --perf. The
+ * group is opened disabled and enabled when the thread passes the gate. */
+__thread int perf_thread_group = -1;
+
+/* Start gate shared by the threads of one phase. Workers block until every
+ * thread of the phase has been spawned, then all measure against the same
+ * monotonic deadline so their measurement intervals fully overlap. */
+typedef struct {
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    int arrived;                       // Workers waiting at the gate
+    bool open;
+    double start;                      // Window start (monotonic seconds)
+    double deadline;                   // Window end (monotonic seconds)
+} start_gate_t;
+
+start_gate_t phase_gate = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER, 0, false, 0.0, 0.0};
+
+/* Timing layer. Every measurement reads time through monotonic_ns() or
+ * monotonic_seconds(): the invariant TSC scaled by a frequency calibrated
+ * against CLOCK_MONOTONIC_RAW at startup where the CPU has one, otherwise
+ * CLOCK_MONOTONIC_RAW itself. Until timer_init() runs the clock is used. */
+typedef enum {
+    TIMER_SOURCE_CLOCK,                // clock_gettime(CLOCK_MONOTONIC_RAW)
+    TIMER_SOURCE_TSC                   // rdtscp (or lfence + rdtsc), calibrated
+} timer_source_t;
+
+#define TIMER_CALIBRATION_US 50000                      // Per calibration round
+#define TIMER_CALIBRATION_TOLERANCE 0.001               // Rounds must agree within 0.1%
+#define TIMER_OVERHEAD_SAMPLES 100000
+
+timer_source_t timer_source = TIMER_SOURCE_CLOCK;
+bool timer_has_rdtscp = false;
+double timer_ns_per_tick = 0.0;        // Calibrated TSC period
+uint64_t timer_base_tsc = 0;           // TSC reading at timer_base_ns
+uint64_t timer_base_ns = 0;
+double timer_overhead_ns = 0.0;        // Cost of one monotonic_ns() call
+
+/* CLOCK_MONOTONIC_RAW in integer nanoseconds (not slewed by NTP) */
+uint64_t clock_raw_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+#ifdef HAVE_X86_SIMD
+/* TSC reading ordered after all earlier instructions */
+static inline uint64_t timer_read_tsc(void) {
+    if (timer_has_rdtscp) {
+        unsigned int aux;
+        return __rdtscp(&aux);
+    }
+    _mm_lfence();
+    return __rdtsc();
+}
+#endif
+
+/* Current monotonic time in integer nanoseconds, for timing single
+ * operations */
+uint64_t monotonic_ns(void) {
+#ifdef HAVE_X86_SIMD
+    if (timer_source == TIMER_SOURCE_TSC) {
+        return timer_base_ns + (uint64_t)((double)(timer_read_tsc() - timer_base_tsc) * timer_ns_per_tick);
+    }
+#endif
+    return clock_raw_ns();
+}
+
+/* Current monotonic time in seconds */
+double monotonic_seconds(void) {
+    return monotonic_ns() / BILLION;
+}
+
+/* Nanoseconds since `start` (a monotonic_ns() reading), less the cost of
+ * the reading that ends the interval */
+uint64_t elapsed_ns(uint64_t start) {
+    uint64_t elapsed = monotonic_ns() - start;
+    uint64_t overhead = (uint64_t)timer_overhead_ns;
+    return (elapsed > overhead) ? elapsed - overhead : 0;
+}
+
+/* Share of the interval [start, end] that falls inside the measurement window.
+ * Work done after the common deadline is not counted. */
+double window_fraction(double start, double end, double deadline) {
+    if (end <= deadline) return 1.0;
+    if (start >= deadline || end <= start) return 0.0;
+    return (deadline - start) / (end - start);
+}
+
+/* Per-thread pseudo-random generator (splitmix64); the caller owns the
+ * state, so unlike rand() it is safe to use from every benchmark thread */
+uint64_t random_next(uint64_t* state) {
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/* Log-linear (HDR-style) latency histogram. Values below 2^HISTOGRAM_SUB_BITS
+ * get a bucket each; every further power of two is split into
+ * 2^HISTOGRAM_SUB_BITS linear buckets, so a recorded value is known to
+ * within 1/32 (~3%) at any magnitude. Each thread records into a histogram
+ * of its own without locking and histograms are merged after the phase. */
+#define HISTOGRAM_SUB_BITS 5
+#define HISTOGRAM_SUB_COUNT (1 << HISTOGRAM_SUB_BITS)
+#define HISTOGRAM_MAX_BITS 44                   // Larger values share the last bucket
+#define HISTOGRAM_BUCKETS ((HISTOGRAM_MAX_BITS - HISTOGRAM_SUB_BITS + 1) * HISTOGRAM_SUB_COUNT)
+
+typedef struct {
+    uint64_t count;
+    uint64_t max;
+    double sum;
+    uint64_t buckets[HISTOGRAM_BUCKETS];
+} latency_histogram_t;
+
+/* Percentiles reported for every histogram, followed by the maximum */
+#define HISTOGRAM_NUM_PERCENTILES 4
+const double histogram_percentiles[HISTOGRAM_NUM_PERCENTILES] = {50.0, 90.0, 99.0, 99.9};
+
+int histogram_bucket(uint64_t value) {
+    if (value < HISTOGRAM_SUB_COUNT) return (int)value;
+    int exponent = 63 - __builtin_clzll(value);
+    if (exponent >= HISTOGRAM_MAX_BITS) return HISTOGRAM_BUCKETS - 1;
+    int group = exponent - HISTOGRAM_SUB_BITS + 1;
+    int sub = (int)(value >> (exponent - HISTOGRAM_SUB_BITS)) & (HISTOGRAM_SUB_COUNT - 1);
+    return group * HISTOGRAM_SUB_COUNT + sub;
+}
+
+/* Highest value that maps to `bucket` */
+uint64_t histogram_bucket_limit(int bucket) {
+    if (bucket < HISTOGRAM_SUB_COUNT) return (uint64_t)bucket;
+    int group = bucket / HISTOGRAM_SUB_COUNT;
+    uint64_t sub = (uint64_t)(bucket % HISTOGRAM_SUB_COUNT);
+    return ((HISTOGRAM_SUB_COUNT + sub + 1) << (group - 1)) - 1;
+}
+
+void histogram_record(latency_histogram_t* h, uint64_t value) {
+    h->buckets[histogram_bucket(value)]++;
+    h->count++;
+    h->sum += (double)value;
+    if (value > h->max) h->max = value;
+}
+
+void histogram_merge(latency_histogram_t* dst, const latency_histogram_t* src) {
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) dst->buckets[b] += src->buckets[b];
+    dst->count += src->count;
+    dst->sum += src->sum;
+    if (src->max > dst->max) dst->max = src->max;
+}
+
+/* Value below or at which `percentile` percent of the samples fall */
+uint64_t histogram_percentile(const latency_histogram_t* h, double percentile) {
+    if (h->count == 0) return 0;
+    uint64_t rank = (uint64_t)ceil(percentile / 100.0 * (double)h->count);
+    if (rank < 1) rank = 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += h->buckets[b];
+        if (seen >= rank) {
+            uint64_t limit = histogram_bucket_limit(b);
+            return (limit < h->max) ? limit : h->max;
+        }
+    }
+    return h->max;
+}
+
+/* Next batch size in the continuous profile: rescale the last batch so that
+ * one batch takes about slice_ms, growing at most 4x per step so a cold first
+ * batch cannot overshoot. The bursty profile keeps its fixed batch size. */
+long long calibrate_batch(long long batch, double elapsed) {
+    if (load_profile != LOAD_PROFILE_CONTINUOUS) return batch;
+    
+    double limit = batch * 4.0;
+    double scaled = (elapsed > 0) ? batch * (slice_ms / 1000.0) / elapsed : limit;
+    if (scaled > limit) scaled = limit;
+    if (scaled < 1.0) scaled = 1.0;
+    return (long long)scaled;
+}
+
+/* Idle between batches in the bursty profile; continuous load never sleeps */
+void load_profile_pause(void) {
+    if (load_profile == LOAD_PROFILE_BURSTY) {
+        usleep(BURSTY_PAUSE_US);
+    }
+}
+
+/* Reset the gate before spawning the threads of a new phase */
+void start_gate_reset(start_gate_t* gate) {
+    pthread_mutex_lock(&gate->mutex);
+    gate->arrived = 0;
+    gate->open = false;
+    pthread_mutex_unlock(&gate->mutex);
+}
+
+/* Worker side: block until the gate opens and return the shared deadline */
+double start_gate_wait(start_gate_t* gate) {
+    pthread_mutex_lock(&gate->mutex);
+    gate->arrived++;
+    pthread_cond_broadcast(&gate->cond);
+    while (!gate->open) {
+        pthread_cond_wait(&gate->cond, &gate->mutex);
+    }
+    double deadline = gate->deadline;
+    pthread_mutex_unlock(&gate->mutex);
+#ifdef HAVE_PERF_EVENTS
+    if (perf_thread_group >= 0) ioctl(perf_thread_group, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    return deadline;
+}
+
+/* Coordinator side: wait for `expected` workers, then release them all with
+ * a window of `seconds` starting now */
+void start_gate_open(start_gate_t* gate, int expected, double seconds) {
+    pthread_mutex_lock(&gate->mutex);
+    while (gate->arrived < expected) {
+        pthread_cond_wait(&gate->cond, &gate->mutex);
+    }
+    gate->start = monotonic_seconds();
+    gate->deadline = gate->start + seconds;
+    gate->open = true;
+    pthread_cond_broadcast(&gate->cond);
+    pthread_mutex_unlock(&gate->mutex);
 }
 
 /* Thread-safe logging function */
@@ -119,6 +503,56 @@ void verbose_log(const char* format, ...) {
     pthread_mutex_unlock(&log_mutex);
 }
 
+#ifdef HAVE_X86_SIMD
+/* One TSC calibration round against CLOCK_MONOTONIC_RAW: ns per tick */
+double timer_calibration_round(void) {
+    uint64_t tsc0 = timer_read_tsc();
+    uint64_t ns0 = clock_raw_ns();
+    usleep(TIMER_CALIBRATION_US);
+    uint64_t tsc1 = timer_read_tsc();
+    uint64_t ns1 = clock_raw_ns();
+    return (tsc1 > tsc0) ? (double)(ns1 - ns0) / (double)(tsc1 - tsc0) : 0.0;
+}
+#endif
+
+/* Select the time source and measure its overhead; called once before any
+ * benchmark thread starts */
+void timer_init(void) {
+#ifdef HAVE_X86_SIMD
+    unsigned int eax, ebx, ecx, edx;
+    bool invariant = __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8));
+    timer_has_rdtscp = __get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx) && (edx & (1u << 27));
+    if (invariant) {
+        double first = timer_calibration_round();
+        double second = timer_calibration_round();
+        if (first > 0 && fabs(first - second) <= TIMER_CALIBRATION_TOLERANCE * first) {
+            timer_ns_per_tick = (first + second) / 2;
+            timer_base_tsc = timer_read_tsc();
+            timer_base_ns = clock_raw_ns();
+            timer_source = TIMER_SOURCE_TSC;
+        } else {
+            verbose_log("TSC calibration unstable (%.6f vs %.6f ns/tick), using the clock", first, second);
+        }
+    }
+#endif
+    
+    uint64_t start = monotonic_ns();
+    for (int i = 0; i < TIMER_OVERHEAD_SAMPLES; i++) {
+        (void)monotonic_ns();
+    }
+    timer_overhead_ns = (double)(monotonic_ns() - start) / (TIMER_OVERHEAD_SAMPLES + 1);
+}
+
+/* One-line description of the time source for logs and reports */
+void timer_describe(char* text, size_t len) {
+    if (timer_source == TIMER_SOURCE_TSC) {
+        snprintf(text, len, "invariant TSC at %.3f GHz (%s), %.1f ns per reading", 1.0 / timer_ns_per_tick,
+                 timer_has_rdtscp ? "rdtscp" : "lfence+rdtsc", timer_overhead_ns);
+    } else {
+        snprintf(text, len, "CLOCK_MONOTONIC_RAW, %.1f ns per reading", timer_overhead_ns);
+    }
+}
+
 /* Signal handler for graceful termination */
 void signal_handler(int sig) {
     if (sig == SIGINT || sig == SIGTERM) {
@@ -128,20 +562,18 @@ void signal_handler(int sig) {
 }
 
 /* CPU Benchmark Implementation 1: FLOPS Benchmark */
-double cpu_benchmark_impl_flops(int thread_id, int duration) {
+double cpu_benchmark_impl_flops(int thread_id, double deadline) {
     verbose_log("Thread %d: Starting FLOPS benchmark...", thread_id);
     
-    struct timespec start, end;
+    double start, end;
     volatile double result = 0.0;
-    long long total_ops = 0;
-    
-    time_t end_time = time(NULL) + duration;
+    double total_ops = 0;
     double elapsed_total = 0.0;
+    long long ops_per_iter = 1000000;
     
     // Main measurement loop
-    while (running && time(NULL) < end_time) {
-        const long long ops_per_iter = 1000000;
-        clock_gettime(CLOCK_MONOTONIC, &start);
+    while (running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
         
         // Mix of floating-point operations (transcendental and algebraic)
         for (long long i = 1; i <= ops_per_iter && running; i++) {
@@ -149,270 +581,3436 @@ double cpu_benchmark_impl_flops(int thread_id, int duration) {
             result += sin(i * 0.1) * cos(i * 0.2) / sqrt(i + 1.0);
         }
         
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double elapsed = timespec_diff(start, end);
+        end = monotonic_seconds();
+        double in_window = window_fraction(start, end, deadline);
         
-        total_ops += ops_per_iter;
-        elapsed_total += elapsed;
+        total_ops += ops_per_iter * in_window;
+        elapsed_total += (end - start) * in_window;
+        ops_per_iter = calibrate_batch(ops_per_iter, end - start);
         
         // Prevent result from being optimized away
         if (result > 1e100) result = 0.0;
         
-        // Brief pause to prevent CPU hogging
-        usleep(5000);
+        load_profile_pause();
     }
     
-    double flops = (elapsed_total > 0) ? (double)total_ops / elapsed_total : 0;
+    double flops = (elapsed_total > 0) ? total_ops / elapsed_total : 0;
     verbose_log("Thread %d: FLOPS benchmark completed. Result: %.2f FLOPS", thread_id, flops);
     
     return flops;
 }
 
-/* Memory Benchmark Implementation 1: Bandwidth */
-void memory_benchmark_impl_bandwidth(int thread_id, int duration, 
-                                   double *read_bw, double *write_bw) {
-    verbose_log("Thread %d: Starting memory bandwidth benchmark...", thread_id);
-    
-    struct timespec start, end;
-    size_t buffer_size = memory_block_size;
+/* Peak FLOPS kernel variants. Each runs PEAK_FLOPS_CHAINS independent
+ * accumulator chains of acc = acc * mul + add so the FP pipes never wait on
+ * a dependency; the multiplier keeps every chain bounded and away from
+ * denormals. Each step of one chain is one multiply and one add per lane. */
+#define PEAK_FLOPS_MUL 0.999999
+#define PEAK_FLOPS_ADD 0.000001
+
+#define PEAK_FLOPS_REPEAT(STEP) \
+    STEP(0) STEP(1) STEP(2) STEP(3) STEP(4) STEP(5) \
+    STEP(6) STEP(7) STEP(8) STEP(9) STEP(10) STEP(11)
+
+/* Portable fallback: plain C arithmetic, 2 FLOPs per chain step */
+double peak_flops_kernel_scalar(long long iterations) {
+    double acc[PEAK_FLOPS_CHAINS];
+    for (int k = 0; k < PEAK_FLOPS_CHAINS; k++) acc[k] = 1.0 + k * 0.01;
     
-    // Allocate aligned memory for benchmark
-    char* buffer = (char*)malloc(buffer_size);
-    if (!buffer) {
-        log_message("Thread %d: Memory allocation failed for bandwidth test", thread_id);
-        *read_bw = *write_bw = 0;
-        return;
+    for (long long i = 0; i < iterations; i++) {
+#define SCALAR_STEP(k) acc[k] = acc[k] * PEAK_FLOPS_MUL + PEAK_FLOPS_ADD;
+        PEAK_FLOPS_REPEAT(SCALAR_STEP)
+#undef SCALAR_STEP
     }
     
-    time_t end_time = time(NULL) + duration;
-    double total_read_bytes = 0, total_read_time = 0;
-    double total_write_bytes = 0, total_write_time = 0;
+    double sum = 0.0;
+    for (int k = 0; k < PEAK_FLOPS_CHAINS; k++) sum += acc[k];
+    return sum;
+}
+
+#ifdef HAVE_X86_SIMD
+/* SSE2: no FMA, so each step is a separate mulpd + addpd on 2 lanes */
+__attribute__((target("sse2")))
+double peak_flops_kernel_sse2(long long iterations) {
+    const __m128d mul = _mm_set1_pd(PEAK_FLOPS_MUL);
+    const __m128d add = _mm_set1_pd(PEAK_FLOPS_ADD);
+#define SSE2_INIT(k) __m128d acc##k = _mm_set1_pd(1.0 + k * 0.01);
+    PEAK_FLOPS_REPEAT(SSE2_INIT)
+#undef SSE2_INIT
     
-    // Main measurement loop
-    while (running && time(NULL) < end_time) {
-        // WRITE benchmark
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        
-        for (int iter = 0; iter < 5 && running; iter++) {
-            memset(buffer, (iter * thread_id) & 0xFF, buffer_size);
-        }
-        
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double write_time = timespec_diff(start, end);
-        total_write_time += write_time;
-        total_write_bytes += 5 * buffer_size;
-        
-        // READ benchmark
-        volatile unsigned char checksum = 0;  // Prevent optimization
-        
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        
-        for (int iter = 0; iter < 5 && running; iter++) {
-            for (size_t i = 0; i < buffer_size; i += 128) {
-                checksum ^= buffer[i];
-            }
-        }
-        
-        clock_gettime(CLOCK_MONOTONIC, &end);
-        double read_time = timespec_diff(start, end);
-        total_read_time += read_time;
-        total_read_bytes += 5 * buffer_size;
-        
-        // Ensure checksum is used
-        if (checksum == 0xFF) buffer[0] = 0;
-        
-        usleep(5000);  // Brief pause
+    for (long long i = 0; i < iterations; i++) {
+#define SSE2_STEP(k) acc##k = _mm_add_pd(_mm_mul_pd(acc##k, mul), add);
+        PEAK_FLOPS_REPEAT(SSE2_STEP)
+#undef SSE2_STEP
     }
     
-    // Calculate bandwidth in MB/s
-    *read_bw = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
-    *write_bw = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
+    __m128d sum = _mm_setzero_pd();
+#define SSE2_SUM(k) sum = _mm_add_pd(sum, acc##k);
+    PEAK_FLOPS_REPEAT(SSE2_SUM)
+#undef SSE2_SUM
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1];
+}
+
+/* AVX2: one vfmadd on 4 lanes per step */
+__attribute__((target("avx2,fma")))
+double peak_flops_kernel_avx2(long long iterations) {
+    const __m256d mul = _mm256_set1_pd(PEAK_FLOPS_MUL);
+    const __m256d add = _mm256_set1_pd(PEAK_FLOPS_ADD);
+#define AVX2_INIT(k) __m256d acc##k = _mm256_set1_pd(1.0 + k * 0.01);
+    PEAK_FLOPS_REPEAT(AVX2_INIT)
+#undef AVX2_INIT
     
-    verbose_log("Thread %d: Memory bandwidth benchmark completed. Read: %.2f MB/s, Write: %.2f MB/s", 
-               thread_id, *read_bw, *write_bw);
+    for (long long i = 0; i < iterations; i++) {
+#define AVX2_STEP(k) acc##k = _mm256_fmadd_pd(acc##k, mul, add);
+        PEAK_FLOPS_REPEAT(AVX2_STEP)
+#undef AVX2_STEP
+    }
     
-    free(buffer);
+    __m256d sum = _mm256_setzero_pd();
+#define AVX2_SUM(k) sum = _mm256_add_pd(sum, acc##k);
+    PEAK_FLOPS_REPEAT(AVX2_SUM)
+#undef AVX2_SUM
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
 }
 
-/* Disk Benchmark Implementation 1: Throughput and IOPS */
-void disk_benchmark_impl_throughput(int thread_id, int duration, const char* filename,
-                                 double *read_tp, double *write_tp, double *iops) {
-    verbose_log("Thread %d: Starting disk throughput benchmark...", thread_id);
+/* AVX-512: one vfmadd on 8 lanes per step */
+__attribute__((target("avx512f")))
+double peak_flops_kernel_avx512(long long iterations) {
+    const __m512d mul = _mm512_set1_pd(PEAK_FLOPS_MUL);
+    const __m512d add = _mm512_set1_pd(PEAK_FLOPS_ADD);
+#define AVX512_INIT(k) __m512d acc##k = _mm512_set1_pd(1.0 + k * 0.01);
+    PEAK_FLOPS_REPEAT(AVX512_INIT)
+#undef AVX512_INIT
     
-    struct timespec start, end;
-    
-    // Allocate buffer for disk operations
-    char* buffer = (char*)malloc(file_size);
-    if (!buffer) {
-        log_message("Thread %d: Memory allocation failed for disk test", thread_id);
-        *read_tp = *write_tp = *iops = 0;
-        return;
+    for (long long i = 0; i < iterations; i++) {
+#define AVX512_STEP(k) acc##k = _mm512_fmadd_pd(acc##k, mul, add);
+        PEAK_FLOPS_REPEAT(AVX512_STEP)
+#undef AVX512_STEP
     }
     
-    // Initialize buffer with pattern data
-    for (size_t i = 0; i < file_size; i++) {
-        buffer[i] = (char)((i + thread_id) % 256);
+    __m512d sum = _mm512_setzero_pd();
+#define AVX512_SUM(k) sum = _mm512_add_pd(sum, acc##k);
+    PEAK_FLOPS_REPEAT(AVX512_SUM)
+#undef AVX512_SUM
+    return _mm512_reduce_add_pd(sum);
+}
+#endif
+
+/* Peak FLOPS implementation selected at runtime */
+typedef struct {
+    const char* name;
+    double (*kernel)(long long iterations);
+    double flops_per_iteration;        // Real FLOPs per outer iteration
+} peak_flops_impl_t;
+
+/* Pick the widest variant the running CPU (and OS) supports, via cpuid */
+peak_flops_impl_t select_peak_flops_impl(void) {
+    peak_flops_impl_t impl = {"scalar", peak_flops_kernel_scalar, 2.0 * PEAK_FLOPS_CHAINS};
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        impl = (peak_flops_impl_t){"AVX-512", peak_flops_kernel_avx512, 2.0 * 8 * PEAK_FLOPS_CHAINS};
+    } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        impl = (peak_flops_impl_t){"AVX2+FMA", peak_flops_kernel_avx2, 2.0 * 4 * PEAK_FLOPS_CHAINS};
+    } else if (__builtin_cpu_supports("sse2")) {
+        impl = (peak_flops_impl_t){"SSE2", peak_flops_kernel_sse2, 2.0 * 2 * PEAK_FLOPS_CHAINS};
     }
+#endif
+    return impl;
+}
+
+/* CPU Benchmark Implementation 2: Peak FLOPS */
+double cpu_benchmark_impl_peak_flops(int thread_id, double deadline) {
+    peak_flops_impl_t impl = select_peak_flops_impl();
+    verbose_log("Thread %d: Starting %s peak FLOPS benchmark...", thread_id, impl.name);
     
-    time_t end_time = time(NULL) + duration;
-    double total_read_bytes = 0, total_read_time = 0;
-    double total_write_bytes = 0, total_write_time = 0;
-    double total_seek_ops = 0, total_seek_time = 0;
+    double start, end;
+    volatile double result = 0.0;
+    double total_flops = 0;
+    double elapsed_total = 0.0;
+    long long iterations = 100000;
     
     // Main measurement loop
-    while (running && time(NULL) < end_time) {
-        // WRITE benchmark
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        
-        FILE* file = fopen(filename, "wb");
-        if (file) {
-            size_t written = fwrite(buffer, 1, file_size, file);
-            fclose(file);
-            
-            if (written > 0) {
-                clock_gettime(CLOCK_MONOTONIC, &end);
-                double elapsed = timespec_diff(start, end);
-                total_write_time += elapsed;
-                total_write_bytes += written;
-            }
-        }
-        
-        // READ benchmark
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        
-        file = fopen(filename, "rb");
-        if (file) {
-            size_t bytes_read = fread(buffer, 1, file_size, file);
-            fclose(file);
-            
-            if (bytes_read > 0) {
-                clock_gettime(CLOCK_MONOTONIC, &end);
-                double elapsed = timespec_diff(start, end);
-                total_read_time += elapsed;
-                total_read_bytes += bytes_read;
-            }
-        }
+    while (running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
+        result += impl.kernel(iterations);
+        end = monotonic_seconds();
         
-        // IOPS (Random access) benchmark
-        const int iops_iterations = 100;
-        clock_gettime(CLOCK_MONOTONIC, &start);
-        
-        file = fopen(filename, "r+b");
-        if (file) {
-            char small_buf[512];
-            for (int i = 0; i < iops_iterations && running; i++) {
-                long pos = rand() % (file_size - sizeof(small_buf));
-                fseek(file, pos, SEEK_SET);
-                fread(small_buf, 1, sizeof(small_buf), file);
-            }
-            fclose(file);
-            
-            clock_gettime(CLOCK_MONOTONIC, &end);
-            double elapsed = timespec_diff(start, end);
-            total_seek_time += elapsed;
-            total_seek_ops += iops_iterations;
-        }
+        double in_window = window_fraction(start, end, deadline);
+        total_flops += iterations * impl.flops_per_iteration * in_window;
+        elapsed_total += (end - start) * in_window;
+        iterations = calibrate_batch(iterations, end - start);
         
-        usleep(5000);  // Brief pause
+        load_profile_pause();
     }
     
-    // Calculate metrics
-    *read_tp = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
-    *write_tp = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
-    *iops = (total_seek_time > 0) ? total_seek_ops / total_seek_time : 0;
-    
-    verbose_log("Thread %d: Disk benchmark completed. Read: %.2f MB/s, Write: %.2f MB/s, IOPS: %.2f",
-               thread_id, *read_tp, *write_tp, *iops);
+    double flops = (elapsed_total > 0) ? total_flops / elapsed_total : 0;
+    verbose_log("Thread %d: Peak FLOPS benchmark completed. Result: %.2f GFLOPS (checksum %.3f)",
+                thread_id, flops / BILLION, result);
     
-    free(buffer);
+    return flops;
 }
 
-/* CPU benchmark thread function */
-void* cpu_benchmark(void* args) {
-    thread_args_t* t_args = (thread_args_t*)args;
-    log_message("CPU benchmark thread %d started", t_args->thread_id);
-    
-    // Run the FLOPS benchmark
-    double flops = cpu_benchmark_impl_flops(t_args->thread_id, t_args->duration);
-    
-    pthread_mutex_lock(&results_mutex);
-    t_args->thread_results.cpu_flops = flops;
-    if (t_args->thread_id == 0) {  // Only record global results from thread 0
-        global_results.cpu_flops = flops;
+/* Vectorized transcendental kernel: the exact workload of
+ * cpu_benchmark_impl_flops() (sin(0.1i) * cos(0.2i) / sqrt(i + 1)) with sin
+ * and cos evaluated lane-parallel instead of through scalar libm calls.
+ * Arguments are reduced to [-pi/4, pi/4] by Cody-Waite subtraction of a
+ * three-part pi/2 and evaluated with the fdlibm minimax polynomials. The
+ * reduction is exact while the quadrant index stays below 2^20, which
+ * bounds the batch size. */
+#define TRANSCENDENTAL_MAX_BATCH (1LL << 22)            // Keeps 0.2 * i below 2^20 * pi/2
+#define TRANSCENDENTAL_ULP_BOUND 4.0                    // Accepted max error vs libm
+#define TRANSCENDENTAL_VERIFY_POINTS 65536
+
+#define VT_TWO_OVER_PI 6.36619772367581382433e-01
+#define VT_PIO2_1 1.57079632673412561417e+00            // First 33 bits of pi/2
+#define VT_PIO2_2 6.07710050630396597660e-11            // Next 33 bits
+#define VT_PIO2_3 2.02226624871116645580e-21            // Remaining bits
+#define VT_ROUND_SHIFTER 6755399441055744.0             // 1.5 * 2^52: rounds and exposes low integer bits
+
+typedef double v2df_t __attribute__((vector_size(16)));
+typedef long long v2di_t __attribute__((vector_size(16)));
+typedef double v4df_t __attribute__((vector_size(32)));
+typedef long long v4di_t __attribute__((vector_size(32)));
+typedef double v8df_t __attribute__((vector_size(64)));
+typedef long long v8di_t __attribute__((vector_size(64)));
+
+/* Instantiate sin/cos, an array helper for verification and the benchmark
+ * kernel for one vector width. ATTR carries the target() attribute, SQRT
+ * the lane-wise square root for that width. */
+#define DEFINE_VECTOR_TRANSCENDENTAL(SUFFIX, VD, VI, LANES, ATTR, SQRT)              \
+ATTR static inline VD vt_sin_quadrant_##SUFFIX(VD x, long long offset) {             \
+    VD k = x * VT_TWO_OVER_PI + VT_ROUND_SHIFTER;                                    \
+    VD n = k - VT_ROUND_SHIFTER;                                                     \
+    VI q = (VI)k + offset;                                                           \
+    VD r = x - n * VT_PIO2_1;                                                        \
+    r = r - n * VT_PIO2_2;                                                           \
+    r = r - n * VT_PIO2_3;                                                           \
+    VD z = r * r;                                                                    \
+    VD sp = 2.75573137070700676789e-06 + z * (-2.50507602534068634195e-08 +          \
+            z * 1.58969099521155010221e-10);                                         \
+    sp = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * sp);    \
+    VD s = r + (z * r) * (-1.66666666666666324348e-01 + z * sp);                     \
+    VD cp = -2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 +          \
+            z * -1.13596475577881948265e-11);                                        \
+    cp = 4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 +             \
+         z * (2.48015872894767294178e-05 + z * cp));                                 \
+    VD c = (1.0 - 0.5 * z) + (z * z) * cp;                                           \
+    VI odd = (q & 1) != 0;                                                           \
+    VI res = ((VI)c & odd) | ((VI)s & ~odd);                                         \
+    return (VD)(res ^ ((q & 2) << 62));                                              \
+}                                                                                    \
+                                                                                     \
+ATTR void vt_sincos_array_##SUFFIX(const double* x, double* s, double* c, int n) {   \
+    for (int i = 0; i + LANES <= n; i += LANES) {                                    \
+        VD v;                                                                        \
+        memcpy(&v, x + i, sizeof(v));                                                \
+        VD vs = vt_sin_quadrant_##SUFFIX(v, 0);                                      \
+        VD vc = vt_sin_quadrant_##SUFFIX(v, 1);                                      \
+        memcpy(s + i, &vs, sizeof(vs));                                              \
+        memcpy(c + i, &vc, sizeof(vc));                                              \
+    }                                                                                \
+}                                                                                    \
+                                                                                     \
+ATTR double vt_kernel_##SUFFIX(long long count) {                                    \
+    VD acc = {0};                                                                    \
+    VD idx;                                                                          \
+    for (int k = 0; k < LANES; k++) idx[k] = 1.0 + k;                                \
+    for (long long i = 0; i < count; i += LANES) {                                   \
+        acc += vt_sin_quadrant_##SUFFIX(idx * 0.1, 0) *                              \
+               vt_sin_quadrant_##SUFFIX(idx * 0.2, 1) / SQRT(idx + 1.0);             \
+        idx += LANES;                                                                \
+    }                                                                                \
+    double sum = 0.0;                                                                \
+    for (int k = 0; k < LANES; k++) sum += acc[k];                                   \
+    return sum;                                                                      \
+}
+
+/* Lane-wise square root for the portable 2-lane (SSE2/NEON) instantiation */
+static inline v2df_t vt_sqrt_generic(v2df_t x) {
+    for (int k = 0; k < 2; k++) x[k] = sqrt(x[k]);
+    return x;
+}
+
+DEFINE_VECTOR_TRANSCENDENTAL(generic, v2df_t, v2di_t, 2, , vt_sqrt_generic)
+
+#ifdef HAVE_X86_SIMD
+#define VT_SQRT_AVX2(x) ((v4df_t)_mm256_sqrt_pd((__m256d)(x)))
+#define VT_SQRT_AVX512(x) ((v8df_t)_mm512_sqrt_pd((__m512d)(x)))
+DEFINE_VECTOR_TRANSCENDENTAL(avx2, v4df_t, v4di_t, 4, __attribute__((target("avx2,fma"))), VT_SQRT_AVX2)
+DEFINE_VECTOR_TRANSCENDENTAL(avx512, v8df_t, v8di_t, 8, __attribute__((target("avx512f"))), VT_SQRT_AVX512)
+#endif
+
+/* Vectorized transcendental implementation selected at runtime */
+typedef struct {
+    const char* name;
+    int lanes;
+    double (*kernel)(long long count);
+    void (*sincos_array)(const double* x, double* s, double* c, int n);
+} vector_transcendental_impl_t;
+
+/* Pick the widest vector math variant the running CPU supports */
+vector_transcendental_impl_t select_vector_transcendental_impl(void) {
+    vector_transcendental_impl_t impl = {"generic x2", 2, vt_kernel_generic, vt_sincos_array_generic};
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        impl = (vector_transcendental_impl_t){"AVX-512 x8", 8, vt_kernel_avx512, vt_sincos_array_avx512};
+    } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        impl = (vector_transcendental_impl_t){"AVX2 x4", 4, vt_kernel_avx2, vt_sincos_array_avx2};
     }
-    pthread_mutex_unlock(&results_mutex);
-    
-    log_message("CPU benchmark thread %d completed. Result: %.2f MFLOPS", 
-                t_args->thread_id, flops / 1000000.0);
-    return NULL;
+#endif
+    return impl;
 }
 
-/* Memory benchmark thread function */
-void* memory_benchmark(void* args) {
-    thread_args_t* t_args = (thread_args_t*)args;
-    log_message("Memory benchmark thread %d started", t_args->thread_id);
-    
-    double read_bandwidth = 0.0, write_bandwidth = 0.0;
-    
-    // Run the memory bandwidth benchmark
-    memory_benchmark_impl_bandwidth(t_args->thread_id, t_args->duration, 
-                                  &read_bandwidth, &write_bandwidth);
+/* Error of `value` against the libm reference in units in the last place */
+double ulp_error(double value, double reference) {
+    double ulp = nextafter(fabs(reference), INFINITY) - fabs(reference);
+    return fabs(value - reference) / ulp;
+}
+
+/* Accuracy check of the selected vector implementation against libm: the
+ * max ULP error of sin and cos over the whole argument range the kernel
+ * uses, and the relative difference of one batch's checksum vs the scalar
+ * loop. Returns false when the ULP bound is exceeded. */
+bool verify_vector_transcendental(vector_transcendental_impl_t impl,
+                                  double* max_ulp, double* checksum_rel_diff) {
+    const int n = TRANSCENDENTAL_VERIFY_POINTS;
+    double* x = malloc(3 * n * sizeof(double));
+    if (!x) {
+        *max_ulp = *checksum_rel_diff = INFINITY;
+        return false;
+    }
+    double* s = x + n;
+    double* c = x + 2 * n;
     
-    pthread_mutex_lock(&results_mutex);
-    t_args->thread_results.memory_read_bandwidth = read_bandwidth;
-    t_args->thread_results.memory_write_bandwidth = write_bandwidth;
+    // Sample the kernel's argument range [0.1, 0.2 * TRANSCENDENTAL_MAX_BATCH]
+    uint64_t seed = 0;
+    for (int i = 0; i < n; i++) {
+        double u = (random_next(&seed) >> 11) * (1.0 / 9007199254740992.0);
+        x[i] = 0.1 * floor(1.0 + u * 2.0 * TRANSCENDENTAL_MAX_BATCH);
+    }
+    impl.sincos_array(x, s, c, n);
     
-    // Fix: Check if this is the first memory thread (thread_id == num_threads)
-    if (t_args->thread_id == num_threads) {  // First memory thread
-        global_results.memory_read_bandwidth = read_bandwidth;
-        global_results.memory_write_bandwidth = write_bandwidth;
+    *max_ulp = 0.0;
+    for (int i = 0; i < n; i++) {
+        double e_sin = ulp_error(s[i], sin(x[i]));
+        double e_cos = ulp_error(c[i], cos(x[i]));
+        if (e_sin > *max_ulp) *max_ulp = e_sin;
+        if (e_cos > *max_ulp) *max_ulp = e_cos;
     }
-    pthread_mutex_unlock(&results_mutex);
+    free(x);
     
-    log_message("Memory benchmark thread %d completed. Read: %.2f MB/s, Write: %.2f MB/s",
-                t_args->thread_id, read_bandwidth, write_bandwidth);
+    // Checksum of one batch against the scalar libm loop
+    const long long count = 1 << 16;
+    double scalar = 0.0;
+    for (long long i = 1; i <= count; i++) {
+        scalar += sin(i * 0.1) * cos(i * 0.2) / sqrt(i + 1.0);
+    }
+    double vector = impl.kernel(count);
+    *checksum_rel_diff = fabs(vector - scalar) / fabs(scalar);
     
-    return NULL;
+    return *max_ulp <= TRANSCENDENTAL_ULP_BOUND;
 }
 
-/* I/O benchmark thread function */
-void* io_benchmark(void* args) {
-    thread_args_t* t_args = (thread_args_t*)args;
-    log_message("I/O benchmark thread %d started", t_args->thread_id);
-    
-    double read_throughput = 0.0, write_throughput = 0.0, seek_iops = 0.0;
-    
-    // Run the disk throughput benchmark
-    disk_benchmark_impl_throughput(t_args->thread_id, t_args->duration, t_args->temp_filename,
-                                &read_throughput, &write_throughput, &seek_iops);
+/* CPU Benchmark Implementation 3: Vectorized transcendental */
+double cpu_benchmark_impl_vector_flops(int thread_id, double deadline) {
+    vector_transcendental_impl_t impl = select_vector_transcendental_impl();
+    verbose_log("Thread %d: Starting %s vectorized transcendental benchmark...", thread_id, impl.name);
     
-    pthread_mutex_lock(&results_mutex);
-    t_args->thread_results.disk_read_throughput = read_throughput;
-    t_args->thread_results.disk_write_throughput = write_throughput;
-    t_args->thread_results.disk_seek_iops = seek_iops;
+    double start, end;
+    volatile double result = 0.0;
+    double total_ops = 0;
+    double elapsed_total = 0.0;
+    long long ops_per_iter = 1000000;
     
-    // Fix: Check if this is the first I/O thread (thread_id == 2*num_threads)
-    if (t_args->thread_id == 2 * num_threads) {  // First I/O thread
-        global_results.disk_read_throughput = read_throughput;
-        global_results.disk_write_throughput = write_throughput;
-        global_results.disk_seek_iops = seek_iops;
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        // Whole vectors only, and small enough for exact argument reduction
+        if (ops_per_iter > TRANSCENDENTAL_MAX_BATCH) ops_per_iter = TRANSCENDENTAL_MAX_BATCH;
+        ops_per_iter = (ops_per_iter + impl.lanes - 1) / impl.lanes * impl.lanes;
+        
+        start = monotonic_seconds();
+        result += impl.kernel(ops_per_iter);
+        end = monotonic_seconds();
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_ops += ops_per_iter * in_window;
+        elapsed_total += (end - start) * in_window;
+        ops_per_iter = calibrate_batch(ops_per_iter, end - start);
+        
+        // Prevent result from being optimized away
+        if (result > 1e100) result = 0.0;
+        
+        load_profile_pause();
     }
-    pthread_mutex_unlock(&results_mutex);
     
-    log_message("I/O benchmark thread %d completed. Read: %.2f MB/s, Write: %.2f MB/s, IOPS: %.2f",
-                t_args->thread_id, read_throughput, write_throughput, seek_iops);
+    double flops = (elapsed_total > 0) ? total_ops / elapsed_total : 0;
+    verbose_log("Thread %d: Vectorized transcendental benchmark completed. Result: %.2f FLOPS",
+                thread_id, flops);
     
-    return NULL;
+    return flops;
 }
 
-/* Calculate benchmark scores */
-void calculate_benchmark_scores() {
-    // Calculate individual component scores (1000 points = reference system)
-    
-    // CPU Score: based on FLOPS performance relative to reference
-    double cpu_ratio = global_results.cpu_flops / CPU_REFERENCE_FLOPS;
-    global_results.cpu_score = (int)(1000 * cpu_ratio);
-    
+/* DGEMM kernel: C = A * B on square row-major matrices, blocked the way
+ * BLIS/GotoBLAS do it. A KC x NC panel of B is packed to stay in L3, an
+ * MC x KC block of A is packed to stay in L2, and an MR x NR register tile
+ * of C is updated by a micro-kernel streaming a KC x NR sliver of B from
+ * L1. Each thread owns a contiguous band of C rows. */
+#define DGEMM_MC 128                                    // A block rows (L2)
+#define DGEMM_KC 256                                    // Shared dimension block (L1/L2)
+#define DGEMM_NC 1024                                   // B panel columns (L3)
+#define DGEMM_VERIFY_SIZE 131                           // Odd size exercises every edge path
+
+const int dgemm_sizes[] = {64, 128, 256, 512, 1024, 2048};
+#define DGEMM_NUM_SIZES ((int)(sizeof(dgemm_sizes) / sizeof(dgemm_sizes[0])))
+
+/* Micro-kernel: C[MR x NR] += Ap[KC x MR] * Bp[KC x NR], both packed */
+typedef void (*dgemm_ukernel_fn)(int kc, const double* a, const double* b, double* c, int ldc);
+
+/* Portable 4x4 micro-kernel */
+void dgemm_ukernel_scalar(int kc, const double* a, const double* b, double* c, int ldc) {
+    double acc[4][4] = {{0}};
+    for (int p = 0; p < kc; p++) {
+        for (int i = 0; i < 4; i++) {
+            for (int j = 0; j < 4; j++) {
+                acc[i][j] += a[p * 4 + i] * b[p * 4 + j];
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            c[i * ldc + j] += acc[i][j];
+        }
+    }
+}
+
+#ifdef HAVE_X86_SIMD
+#define DGEMM_ROWS4(STEP) STEP(0) STEP(1) STEP(2) STEP(3)
+#define DGEMM_ROWS8(STEP) STEP(0) STEP(1) STEP(2) STEP(3) STEP(4) STEP(5) STEP(6) STEP(7)
+
+/* AVX2 4x8 micro-kernel: 8 ymm accumulators, 2 B loads and 4 broadcasts per k */
+__attribute__((target("avx2,fma")))
+void dgemm_ukernel_avx2(int kc, const double* a, const double* b, double* c, int ldc) {
+#define AVX2_ACC(i) __m256d c##i##0 = _mm256_setzero_pd(), c##i##1 = _mm256_setzero_pd();
+    DGEMM_ROWS4(AVX2_ACC)
+#undef AVX2_ACC
+    for (int p = 0; p < kc; p++) {
+        __m256d b0 = _mm256_loadu_pd(b + p * 8);
+        __m256d b1 = _mm256_loadu_pd(b + p * 8 + 4);
+#define AVX2_FMA(i) { __m256d ai = _mm256_broadcast_sd(a + p * 4 + i);          \
+                      c##i##0 = _mm256_fmadd_pd(ai, b0, c##i##0);               \
+                      c##i##1 = _mm256_fmadd_pd(ai, b1, c##i##1); }
+        DGEMM_ROWS4(AVX2_FMA)
+#undef AVX2_FMA
+    }
+#define AVX2_STORE(i) \
+    _mm256_storeu_pd(c + i * ldc, _mm256_add_pd(_mm256_loadu_pd(c + i * ldc), c##i##0));         \
+    _mm256_storeu_pd(c + i * ldc + 4, _mm256_add_pd(_mm256_loadu_pd(c + i * ldc + 4), c##i##1));
+    DGEMM_ROWS4(AVX2_STORE)
+#undef AVX2_STORE
+}
+
+/* AVX-512 8x16 micro-kernel: 16 zmm accumulators, 2 B loads and 8 broadcasts per k */
+__attribute__((target("avx512f")))
+void dgemm_ukernel_avx512(int kc, const double* a, const double* b, double* c, int ldc) {
+#define AVX512_ACC(i) __m512d c##i##0 = _mm512_setzero_pd(), c##i##1 = _mm512_setzero_pd();
+    DGEMM_ROWS8(AVX512_ACC)
+#undef AVX512_ACC
+    for (int p = 0; p < kc; p++) {
+        __m512d b0 = _mm512_loadu_pd(b + p * 16);
+        __m512d b1 = _mm512_loadu_pd(b + p * 16 + 8);
+#define AVX512_FMA(i) { __m512d ai = _mm512_set1_pd(a[p * 8 + i]);              \
+                        c##i##0 = _mm512_fmadd_pd(ai, b0, c##i##0);             \
+                        c##i##1 = _mm512_fmadd_pd(ai, b1, c##i##1); }
+        DGEMM_ROWS8(AVX512_FMA)
+#undef AVX512_FMA
+    }
+#define AVX512_STORE(i) \
+    _mm512_storeu_pd(c + i * ldc, _mm512_add_pd(_mm512_loadu_pd(c + i * ldc), c##i##0));         \
+    _mm512_storeu_pd(c + i * ldc + 8, _mm512_add_pd(_mm512_loadu_pd(c + i * ldc + 8), c##i##1));
+    DGEMM_ROWS8(AVX512_STORE)
+#undef AVX512_STORE
+}
+#endif
+
+/* DGEMM micro-kernel selected at runtime */
+typedef struct {
+    const char* name;
+    int mr;
+    int nr;
+    dgemm_ukernel_fn ukernel;
+} dgemm_impl_t;
+
+/* Pick the widest micro-kernel the running CPU supports */
+dgemm_impl_t select_dgemm_impl(void) {
+    dgemm_impl_t impl = {"scalar 4x4", 4, 4, dgemm_ukernel_scalar};
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        impl = (dgemm_impl_t){"AVX-512 8x16", 8, 16, dgemm_ukernel_avx512};
+    } else if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        impl = (dgemm_impl_t){"AVX2 4x8", 4, 8, dgemm_ukernel_avx2};
+    }
+#endif
+    return impl;
+}
+
+/* Shared operands for the matrix size currently being measured */
+typedef struct {
+    int n;
+    double* a;
+    double* b;
+    double* c;
+} dgemm_problem_t;
+
+dgemm_problem_t dgemm_problem = {0};
+thread_stats_t dgemm_stats[DGEMM_NUM_SIZES];   // Per-size reduction; sum is system GFLOPS
+bool dgemm_verified = false;
+
+/* Pack an mc x kc block of A into MR-row slivers, zero-padding the edge */
+void dgemm_pack_a(int mr, int mc, int kc, const double* a, int lda, double* ap) {
+    for (int i0 = 0; i0 < mc; i0 += mr) {
+        for (int p = 0; p < kc; p++) {
+            for (int i = 0; i < mr; i++) {
+                *ap++ = (i0 + i < mc) ? a[(i0 + i) * lda + p] : 0.0;
+            }
+        }
+    }
+}
+
+/* Pack a kc x nc panel of B into NR-column slivers, zero-padding the edge */
+void dgemm_pack_b(int nr, int kc, int nc, const double* b, int ldb, double* bp) {
+    for (int j0 = 0; j0 < nc; j0 += nr) {
+        for (int p = 0; p < kc; p++) {
+            for (int j = 0; j < nr; j++) {
+                *bp++ = (j0 + j < nc) ? b[p * ldb + j0 + j] : 0.0;
+            }
+        }
+    }
+}
+
+/* C[row_begin..row_end) = A[row_begin..row_end) * B for an n x n problem.
+ * ap/bp are per-thread packing buffers of DGEMM_MC*DGEMM_KC and
+ * DGEMM_KC*DGEMM_NC doubles (rounded up to whole slivers). */
+void dgemm_rows(const dgemm_impl_t* impl, int n, const double* a, const double* b, double* c,
+                int row_begin, int row_end, double* ap, double* bp) {
+    const int mr = impl->mr, nr = impl->nr;
+    double edge[16 * 16];              // Scratch tile for partial MR x NR edges
+    
+    for (int i = row_begin; i < row_end; i++) {
+        memset(c + (size_t)i * n, 0, n * sizeof(double));
+    }
+    
+    for (int jc = 0; jc < n; jc += DGEMM_NC) {
+        int nc = (n - jc < DGEMM_NC) ? n - jc : DGEMM_NC;
+        for (int pc = 0; pc < n; pc += DGEMM_KC) {
+            int kc = (n - pc < DGEMM_KC) ? n - pc : DGEMM_KC;
+            dgemm_pack_b(nr, kc, nc, b + (size_t)pc * n + jc, n, bp);
+            
+            for (int ic = row_begin; ic < row_end; ic += DGEMM_MC) {
+                int mc = (row_end - ic < DGEMM_MC) ? row_end - ic : DGEMM_MC;
+                dgemm_pack_a(mr, mc, kc, a + (size_t)ic * n + pc, n, ap);
+                
+                for (int jr = 0; jr < nc; jr += nr) {
+                    for (int ir = 0; ir < mc; ir += mr) {
+                        double* ct = c + (size_t)(ic + ir) * n + jc + jr;
+                        const double* at = ap + (size_t)ir * kc;
+                        const double* bt = bp + (size_t)jr * kc;
+                        
+                        if (ir + mr <= mc && jr + nr <= nc) {
+                            impl->ukernel(kc, at, bt, ct, n);
+                            continue;
+                        }
+                        
+                        // Partial tile: compute into scratch, add the valid part
+                        int m_valid = (mc - ir < mr) ? mc - ir : mr;
+                        int n_valid = (nc - jr < nr) ? nc - jr : nr;
+                        memset(edge, 0, sizeof(edge));
+                        impl->ukernel(kc, at, bt, edge, nr);
+                        for (int i = 0; i < m_valid; i++) {
+                            for (int j = 0; j < n_valid; j++) {
+                                ct[(size_t)i * n + j] += edge[i * nr + j];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* Allocate the per-thread packing buffers for dgemm_rows() */
+bool dgemm_alloc_packing(const dgemm_impl_t* impl, double** ap, double** bp) {
+    size_t a_elems = (size_t)(DGEMM_MC + impl->mr) * DGEMM_KC;
+    size_t b_elems = (size_t)DGEMM_KC * (DGEMM_NC + impl->nr);
+    *ap = *bp = NULL;
+    if (posix_memalign((void**)ap, 64, a_elems * sizeof(double)) != 0) return false;
+    if (posix_memalign((void**)bp, 64, b_elems * sizeof(double)) != 0) {
+        free(*ap);
+        *ap = NULL;
+        return false;
+    }
+    return true;
+}
+
+/* Allocate and fill the shared operands for an n x n problem */
+bool dgemm_problem_init(dgemm_problem_t* problem, int n) {
+    size_t bytes = (size_t)n * n * sizeof(double);
+    memset(problem, 0, sizeof(*problem));
+    problem->n = n;
+    if (posix_memalign((void**)&problem->a, 64, bytes) != 0 ||
+        posix_memalign((void**)&problem->b, 64, bytes) != 0 ||
+        posix_memalign((void**)&problem->c, 64, bytes) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        problem->a[i] = (double)(i % 7) * 0.25 - 0.5;
+        problem->b[i] = (double)(i % 5) * 0.125 + 0.25;
+    }
+    memset(problem->c, 0, bytes);
+    return true;
+}
+
+/* Release the shared operands (safe on partially initialized problems) */
+void dgemm_problem_free(dgemm_problem_t* problem) {
+    free(problem->a);
+    free(problem->b);
+    free(problem->c);
+    memset(problem, 0, sizeof(*problem));
+}
+
+/* Check the blocked product against a naive triple loop on an odd size */
+bool verify_dgemm(const dgemm_impl_t* impl) {
+    dgemm_problem_t problem;
+    double *ap = NULL, *bp = NULL;
+    bool ok = dgemm_problem_init(&problem, DGEMM_VERIFY_SIZE) && dgemm_alloc_packing(impl, &ap, &bp);
+    
+    if (ok) {
+        int n = problem.n;
+        dgemm_rows(impl, n, problem.a, problem.b, problem.c, 0, n, ap, bp);
+        for (int i = 0; i < n && ok; i++) {
+            for (int j = 0; j < n && ok; j++) {
+                double expected = 0.0;
+                for (int p = 0; p < n; p++) expected += problem.a[i * n + p] * problem.b[p * n + j];
+                if (fabs(problem.c[i * n + j] - expected) > 1e-9 * (1.0 + fabs(expected))) ok = false;
+            }
+        }
+    }
+    
+    free(ap);
+    free(bp);
+    dgemm_problem_free(&problem);
+    return ok;
+}
+
+/* CPU Benchmark Implementation 4: DGEMM */
+double cpu_benchmark_impl_dgemm(int thread_id, int thread_index, int thread_count, double deadline) {
+    dgemm_impl_t impl = select_dgemm_impl();
+    const dgemm_problem_t* problem = &dgemm_problem;
+    int n = problem->n;
+    int row_begin = (int)((long long)n * thread_index / thread_count);
+    int row_end = (int)((long long)n * (thread_index + 1) / thread_count);
+    verbose_log("Thread %d: Starting DGEMM benchmark (n=%d, rows %d-%d)...",
+                thread_id, n, row_begin, row_end);
+    
+    double *ap, *bp;
+    if (row_begin == row_end) return 0;
+    if (!dgemm_alloc_packing(&impl, &ap, &bp)) {
+        log_message("Thread %d: Memory allocation failed for DGEMM packing buffers", thread_id);
+        return 0;
+    }
+    
+    double start, end;
+    double total_flops = 0;
+    double elapsed_total = 0.0;
+    double flops_per_rep = 2.0 * (row_end - row_begin) * n * (double)n;
+    
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
+        dgemm_rows(&impl, n, problem->a, problem->b, problem->c, row_begin, row_end, ap, bp);
+        end = monotonic_seconds();
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_flops += flops_per_rep * in_window;
+        elapsed_total += (end - start) * in_window;
+        
+        load_profile_pause();
+    }
+    
+    free(ap);
+    free(bp);
+    
+    double flops = (elapsed_total > 0) ? total_flops / elapsed_total : 0;
+    verbose_log("Thread %d: DGEMM benchmark completed (n=%d). Result: %.2f GFLOPS",
+                thread_id, n, flops / BILLION);
+    
+    return flops;
+}
+
+/* Full-width read kernels: every byte of the buffer is loaded, with four
+ * independent accumulators so the loads are never serialized behind one
+ * dependency chain. The XOR-folded result keeps the loads observable. */
+uint64_t memory_read_kernel_scalar(const void* buffer, size_t bytes) {
+    const uint64_t* p = (const uint64_t*)buffer;
+    size_t n = bytes / sizeof(uint64_t);
+    uint64_t acc0 = 0, acc1 = 0, acc2 = 0, acc3 = 0;
+    size_t i = 0;
+    
+    for (; i + 4 <= n; i += 4) {
+        acc0 ^= p[i];
+        acc1 ^= p[i + 1];
+        acc2 ^= p[i + 2];
+        acc3 ^= p[i + 3];
+    }
+    for (; i < n; i++) acc0 ^= p[i];
+    return acc0 ^ acc1 ^ acc2 ^ acc3;
+}
+
+#ifdef HAVE_X86_SIMD
+/* SSE2: 4 x 16-byte loads per iteration */
+__attribute__((target("sse2")))
+uint64_t memory_read_kernel_sse2(const void* buffer, size_t bytes) {
+    const char* p = (const char*)buffer;
+    __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+    __m128i acc2 = _mm_setzero_si128(), acc3 = _mm_setzero_si128();
+    size_t i = 0;
+    
+    for (; i + 64 <= bytes; i += 64) {
+        acc0 = _mm_xor_si128(acc0, _mm_loadu_si128((const __m128i*)(p + i)));
+        acc1 = _mm_xor_si128(acc1, _mm_loadu_si128((const __m128i*)(p + i + 16)));
+        acc2 = _mm_xor_si128(acc2, _mm_loadu_si128((const __m128i*)(p + i + 32)));
+        acc3 = _mm_xor_si128(acc3, _mm_loadu_si128((const __m128i*)(p + i + 48)));
+    }
+    __m128i acc = _mm_xor_si128(_mm_xor_si128(acc0, acc1), _mm_xor_si128(acc2, acc3));
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i*)lanes, acc);
+    return lanes[0] ^ lanes[1] ^ memory_read_kernel_scalar(p + i, bytes - i);
+}
+
+/* AVX2: 4 x 32-byte loads per iteration */
+__attribute__((target("avx2")))
+uint64_t memory_read_kernel_avx2(const void* buffer, size_t bytes) {
+    const char* p = (const char*)buffer;
+    __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256(), acc3 = _mm256_setzero_si256();
+    size_t i = 0;
+    
+    for (; i + 128 <= bytes; i += 128) {
+        acc0 = _mm256_xor_si256(acc0, _mm256_loadu_si256((const __m256i*)(p + i)));
+        acc1 = _mm256_xor_si256(acc1, _mm256_loadu_si256((const __m256i*)(p + i + 32)));
+        acc2 = _mm256_xor_si256(acc2, _mm256_loadu_si256((const __m256i*)(p + i + 64)));
+        acc3 = _mm256_xor_si256(acc3, _mm256_loadu_si256((const __m256i*)(p + i + 96)));
+    }
+    __m256i acc = _mm256_xor_si256(_mm256_xor_si256(acc0, acc1), _mm256_xor_si256(acc2, acc3));
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, acc);
+    return lanes[0] ^ lanes[1] ^ lanes[2] ^ lanes[3] ^ memory_read_kernel_scalar(p + i, bytes - i);
+}
+
+/* AVX-512: 4 x 64-byte loads per iteration */
+__attribute__((target("avx512f")))
+uint64_t memory_read_kernel_avx512(const void* buffer, size_t bytes) {
+    const char* p = (const char*)buffer;
+    __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+    __m512i acc2 = _mm512_setzero_si512(), acc3 = _mm512_setzero_si512();
+    size_t i = 0;
+    
+    for (; i + 256 <= bytes; i += 256) {
+        acc0 = _mm512_xor_si512(acc0, _mm512_loadu_si512((const void*)(p + i)));
+        acc1 = _mm512_xor_si512(acc1, _mm512_loadu_si512((const void*)(p + i + 64)));
+        acc2 = _mm512_xor_si512(acc2, _mm512_loadu_si512((const void*)(p + i + 128)));
+        acc3 = _mm512_xor_si512(acc3, _mm512_loadu_si512((const void*)(p + i + 192)));
+    }
+    __m512i acc = _mm512_xor_si512(_mm512_xor_si512(acc0, acc1), _mm512_xor_si512(acc2, acc3));
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*)lanes, acc);
+    uint64_t folded = 0;
+    for (int k = 0; k < 8; k++) folded ^= lanes[k];
+    return folded ^ memory_read_kernel_scalar(p + i, bytes - i);
+}
+#endif
+
+/* Full-width read kernel selected at runtime */
+typedef struct {
+    const char* name;
+    uint64_t (*kernel)(const void* buffer, size_t bytes);
+} memory_read_impl_t;
+
+/* Pick the widest load the running CPU supports */
+memory_read_impl_t select_memory_read_impl(void) {
+    memory_read_impl_t impl = {"scalar", memory_read_kernel_scalar};
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        impl = (memory_read_impl_t){"AVX-512", memory_read_kernel_avx512};
+    } else if (__builtin_cpu_supports("avx2")) {
+        impl = (memory_read_impl_t){"AVX2", memory_read_kernel_avx2};
+    } else if (__builtin_cpu_supports("sse2")) {
+        impl = (memory_read_impl_t){"SSE2", memory_read_kernel_sse2};
+    }
+#endif
+    return impl;
+}
+
+/* Non-temporal write kernels: streaming stores bypass the cache, so the
+ * destination lines are not read for ownership first. Each pass ends with
+ * an sfence to drain the write-combining buffers before timing stops.
+ * `buffer` must be 64-byte aligned. */
+#ifdef HAVE_X86_SIMD
+__attribute__((target("sse2")))
+void memory_nt_write_kernel_sse2(void* buffer, size_t bytes, int value) {
+    char* p = (char*)buffer;
+    const __m128i v = _mm_set1_epi8((char)value);
+    size_t i = 0;
+    
+    for (; i + 64 <= bytes; i += 64) {
+        _mm_stream_si128((__m128i*)(p + i), v);
+        _mm_stream_si128((__m128i*)(p + i + 16), v);
+        _mm_stream_si128((__m128i*)(p + i + 32), v);
+        _mm_stream_si128((__m128i*)(p + i + 48), v);
+    }
+    _mm_sfence();
+    memset(p + i, value, bytes - i);
+}
+
+__attribute__((target("avx2")))
+void memory_nt_write_kernel_avx2(void* buffer, size_t bytes, int value) {
+    char* p = (char*)buffer;
+    const __m256i v = _mm256_set1_epi8((char)value);
+    size_t i = 0;
+    
+    for (; i + 128 <= bytes; i += 128) {
+        _mm256_stream_si256((__m256i*)(p + i), v);
+        _mm256_stream_si256((__m256i*)(p + i + 32), v);
+        _mm256_stream_si256((__m256i*)(p + i + 64), v);
+        _mm256_stream_si256((__m256i*)(p + i + 96), v);
+    }
+    _mm_sfence();
+    memset(p + i, value, bytes - i);
+}
+
+__attribute__((target("avx512f")))
+void memory_nt_write_kernel_avx512(void* buffer, size_t bytes, int value) {
+    char* p = (char*)buffer;
+    const __m512i v = _mm512_set1_epi32((int)(0x01010101u * (unsigned char)value));
+    size_t i = 0;
+    
+    for (; i + 256 <= bytes; i += 256) {
+        _mm512_stream_si512((void*)(p + i), v);
+        _mm512_stream_si512((void*)(p + i + 64), v);
+        _mm512_stream_si512((void*)(p + i + 128), v);
+        _mm512_stream_si512((void*)(p + i + 192), v);
+    }
+    _mm_sfence();
+    memset(p + i, value, bytes - i);
+}
+#endif
+
+/* Non-temporal write kernel selected at runtime; kernel is NULL when the
+ * CPU has no streaming stores */
+typedef struct {
+    const char* name;
+    void (*kernel)(void* buffer, size_t bytes, int value);
+} memory_nt_write_impl_t;
+
+/* Pick the widest streaming store the running CPU supports */
+memory_nt_write_impl_t select_memory_nt_write_impl(void) {
+    memory_nt_write_impl_t impl = {"unavailable", NULL};
+#ifdef HAVE_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        impl = (memory_nt_write_impl_t){"AVX-512", memory_nt_write_kernel_avx512};
+    } else if (__builtin_cpu_supports("avx2")) {
+        impl = (memory_nt_write_impl_t){"AVX2", memory_nt_write_kernel_avx2};
+    } else if (__builtin_cpu_supports("sse2")) {
+        impl = (memory_nt_write_impl_t){"SSE2", memory_nt_write_kernel_sse2};
+    }
+#endif
+    return impl;
+}
+
+/* Page backing for the large memory-test buffers. Base pages put a TLB
+ * miss on every 4 KiB of a DRAM-sized buffer; transparent or hugetlbfs
+ * huge pages remove most of them. */
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_2MB
+#define MAP_HUGE_2MB (21 << MAP_HUGE_SHIFT)
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+#define THP_ALIGNMENT (2 * 1024 * 1024)
+
+typedef struct {
+    void* ptr;
+    size_t size;                       // Requested size
+    size_t mapped;                     // Mapping length (rounded to the page size)
+    page_backing_t backing;
+} memory_buffer_t;
+
+page_backing_t page_test_backing = PAGE_BACKING_DEFAULT;   // Backing currently being compared
+thread_stats_t pages_read_stats[PAGE_BACKING_COUNT];
+thread_stats_t pages_write_stats[PAGE_BACKING_COUNT];
+double pages_latency_ns[PAGE_BACKING_COUNT];
+double pages_huge_fraction[PAGE_BACKING_COUNT];             // Mean over the threads
+bool pages_available[PAGE_BACKING_COUNT];
+
+/* Map `size` bytes with exactly the requested backing; false when the
+ * kernel cannot provide it (e.g. no hugetlbfs pages reserved) */
+bool memory_buffer_alloc(memory_buffer_t* buf, size_t size, page_backing_t backing) {
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+    size_t page = 4096;
+    if (backing == PAGE_BACKING_HUGE_2M) {
+        flags |= MAP_HUGETLB | MAP_HUGE_2MB;
+        page = 2UL * 1024 * 1024;
+    } else if (backing == PAGE_BACKING_HUGE_1G) {
+        flags |= MAP_HUGETLB | MAP_HUGE_1GB;
+        page = 1024UL * 1024 * 1024;
+    }
+    
+    size_t mapped = (size + page - 1) / page * page;
+    // THP needs 2 MiB aligned extents, so over-map and trim both ends
+    size_t length = (backing == PAGE_BACKING_THP) ? mapped + THP_ALIGNMENT : mapped;
+    char* base = mmap(NULL, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (base == MAP_FAILED) return false;
+    
+    char* ptr = base;
+    if (backing == PAGE_BACKING_THP) {
+        ptr = (char*)(((uintptr_t)base + THP_ALIGNMENT - 1) & ~(uintptr_t)(THP_ALIGNMENT - 1));
+        if (ptr > base) munmap(base, ptr - base);
+        if (base + length > ptr + mapped) munmap(ptr + mapped, base + length - (ptr + mapped));
+    }
+    
+    int advice = (backing == PAGE_BACKING_THP) ? MADV_HUGEPAGE
+               : (backing == PAGE_BACKING_4K) ? MADV_NOHUGEPAGE : -1;
+    if (advice >= 0 && madvise(ptr, mapped, advice) != 0) {
+        munmap(ptr, mapped);
+        return false;
+    }
+    
+    buf->ptr = ptr;
+    buf->size = size;
+    buf->mapped = mapped;
+    buf->backing = backing;
+    return true;
+}
+
+/* Like memory_buffer_alloc, stepping down 1G -> 2M -> THP -> default
+ * until a backing is available; buf->backing tells which one was used */
+bool memory_buffer_alloc_fallback(memory_buffer_t* buf, size_t size, page_backing_t backing) {
+    for (int b = backing; b >= PAGE_BACKING_THP; b--) {
+        if (memory_buffer_alloc(buf, size, (page_backing_t)b)) return true;
+    }
+    return memory_buffer_alloc(buf, size, (backing == PAGE_BACKING_4K) ? PAGE_BACKING_4K
+                                                                         : PAGE_BACKING_DEFAULT);
+}
+
+void memory_buffer_free(memory_buffer_t* buf) {
+    if (buf->ptr) munmap(buf->ptr, buf->mapped);
+    buf->ptr = NULL;
+}
+
+/* Share of a (touched) buffer actually backed by huge pages, from the
+ * AnonHugePages / KernelPageSize lines of its /proc/self/smaps entry */
+double memory_buffer_huge_fraction(const memory_buffer_t* buf) {
+    FILE* smaps = fopen("/proc/self/smaps", "r");
+    if (!smaps) return 0;
+    
+    char line[256];
+    bool in_mapping = false;
+    double size_kb = 0, huge_kb = 0, kernel_page_kb = 0;
+    while (fgets(line, sizeof(line), smaps)) {
+        unsigned long start, end;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {        // Mapping header line
+            if (in_mapping) break;
+            in_mapping = (start <= (uintptr_t)buf->ptr && (uintptr_t)buf->ptr < end);
+        } else if (in_mapping) {
+            sscanf(line, "Size: %lf kB", &size_kb);
+            sscanf(line, "AnonHugePages: %lf kB", &huge_kb);
+            sscanf(line, "KernelPageSize: %lf kB", &kernel_page_kb);
+        }
+    }
+    fclose(smaps);
+    
+    if (kernel_page_kb > 4) return 1.0;                 // hugetlbfs mapping
+    return (size_kb > 0) ? huge_kb / size_kb : 0;
+}
+
+/* Length of the streaming-store window that follows the scored bandwidth
+ * window; every thread runs it at the same time, so contention matches */
+#define MEMORY_NT_WRITE_SECONDS 1.0
+
+/* Memory Benchmark Implementation 1: Bandwidth */
+void memory_benchmark_impl_bandwidth(int thread_id, double deadline, double *read_bw,
+                                   double *write_bw, double *nt_write_bw, double *touch_bw) {
+    memory_read_impl_t read_impl = select_memory_read_impl();
+    memory_nt_write_impl_t nt_write_impl = select_memory_nt_write_impl();
+    verbose_log("Thread %d: Starting memory bandwidth benchmark (%s reads, %s streaming stores)...",
+                thread_id, read_impl.name, nt_write_impl.name);
+    
+    double start, end, in_window;
+    size_t buffer_size = memory_block_size;
+    
+    // Page-aligned buffer with the requested page backing, or the next best
+    memory_buffer_t mapping;
+    if (!memory_buffer_alloc_fallback(&mapping, buffer_size, memory_page_backing)) {
+        log_message("Thread %d: Memory allocation failed for bandwidth test", thread_id);
+        *read_bw = *write_bw = *nt_write_bw = *touch_bw = 0;
+        return;
+    }
+    char* buffer = mapping.ptr;
+    if (mapping.backing != memory_page_backing) {
+        verbose_log("Thread %d: %s pages unavailable, using %s", thread_id,
+                    page_backing_names[memory_page_backing], page_backing_names[mapping.backing]);
+    }
+    pthread_mutex_lock(&results_mutex);
+    memory_page_backing_used = mapping.backing;
+    pthread_mutex_unlock(&results_mutex);
+    
+    double total_read_bytes = 0, total_read_time = 0;
+    double total_write_bytes = 0, total_write_time = 0;
+    double total_nt_write_bytes = 0, total_nt_write_time = 0;
+    double total_touch_bytes = 0, total_touch_time = 0;
+    long long write_passes = 5, nt_write_passes = 5, read_passes = 5, touch_passes = 5;
+    uint64_t read_checksum = 0;
+    
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        // WRITE benchmark
+        start = monotonic_seconds();
+        
+        for (long long iter = 0; iter < write_passes && running; iter++) {
+            memset(buffer, (iter * thread_id) & 0xFF, buffer_size);
+        }
+        
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, deadline);
+        total_write_time += (end - start) * in_window;
+        total_write_bytes += (double)write_passes * buffer_size * in_window;
+        write_passes = calibrate_batch(write_passes, end - start);
+        
+        // READ benchmark: every byte loaded with full-width vector loads
+        start = monotonic_seconds();
+        
+        for (long long iter = 0; iter < read_passes && running; iter++) {
+            read_checksum ^= read_impl.kernel(buffer, buffer_size);
+        }
+        
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, deadline);
+        total_read_time += (end - start) * in_window;
+        total_read_bytes += (double)read_passes * buffer_size * in_window;
+        read_passes = calibrate_batch(read_passes, end - start);
+        
+        // TOUCH benchmark: one byte per 128, credited with the whole buffer.
+        // This is a cache-line fetch rate, kept for comparison with older runs.
+        volatile unsigned char checksum = 0;  // Prevent optimization
+        
+        start = monotonic_seconds();
+        
+        for (long long iter = 0; iter < touch_passes && running; iter++) {
+            for (size_t i = 0; i < buffer_size; i += 128) {
+                checksum ^= buffer[i];
+            }
+        }
+        
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, deadline);
+        total_touch_time += (end - start) * in_window;
+        total_touch_bytes += (double)touch_passes * buffer_size * in_window;
+        touch_passes = calibrate_batch(touch_passes, end - start);
+        
+        // Ensure checksums are used
+        if (checksum == 0xFF || read_checksum == 1) buffer[0] = 0;
+        
+        load_profile_pause();
+    }
+    
+    // NON-TEMPORAL WRITE benchmark: streaming stores, no read-for-ownership.
+    // Run in its own window after the scored passes so the evictions they
+    // cause cannot change what the scored write and read passes see.
+    double nt_deadline = deadline + MEMORY_NT_WRITE_SECONDS;
+    while (nt_write_impl.kernel && running && monotonic_seconds() < nt_deadline) {
+        start = monotonic_seconds();
+        
+        for (long long iter = 0; iter < nt_write_passes && running; iter++) {
+            nt_write_impl.kernel(buffer, buffer_size, (int)((iter * thread_id) & 0xFF));
+        }
+        
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, nt_deadline);
+        total_nt_write_time += (end - start) * in_window;
+        total_nt_write_bytes += (double)nt_write_passes * buffer_size * in_window;
+        nt_write_passes = calibrate_batch(nt_write_passes, end - start);
+    }
+    
+    // Calculate bandwidth in MB/s
+    *read_bw = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
+    *write_bw = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
+    *nt_write_bw = (total_nt_write_time > 0) ? (total_nt_write_bytes / (1024*1024)) / total_nt_write_time : 0;
+    *touch_bw = (total_touch_time > 0) ? (total_touch_bytes / (1024*1024)) / total_touch_time : 0;
+    
+    verbose_log("Thread %d: Memory bandwidth benchmark completed. Read: %.2f MB/s, Write: %.2f MB/s, "
+                "Non-temporal write: %.2f MB/s, Touch: %.2f MB/s",
+                thread_id, *read_bw, *write_bw, *nt_write_bw, *touch_bw);
+    
+    memory_buffer_free(&mapping);
+}
+
+/* STREAM kernels (McCalpin): Copy c=a, Scale b=s*c, Add c=a+b, Triad a=b+s*c.
+ * Bytes follow the STREAM convention (each array element read or written
+ * counts once); stores into non-cached lines additionally read the line
+ * first (write-allocate), which is reported separately. With
+ * s = sqrt(2) - 1 one Copy/Scale/Add/Triad round leaves a unchanged, so
+ * the arrays never overflow and can be validated at the end. */
+#define STREAM_SCALAR 0.41421356237309515
+#define STREAM_VALIDATE_POINTS 16                       // Strided elements checked per array
+
+typedef enum {
+    STREAM_COPY,
+    STREAM_SCALE,
+    STREAM_ADD,
+    STREAM_TRIAD,
+    STREAM_NUM_KERNELS
+} stream_kernel_t;
+
+const char* const stream_kernel_names[STREAM_NUM_KERNELS] = {"Copy", "Scale", "Add", "Triad"};
+const int stream_arrays_read[STREAM_NUM_KERNELS] = {1, 1, 2, 2};   // Arrays read per element
+const int stream_arrays_written[STREAM_NUM_KERNELS] = {1, 1, 1, 1};
+
+/* Bandwidth including write-allocate traffic for the same elapsed time */
+double stream_write_allocate_bandwidth(stream_kernel_t kernel, double bandwidth) {
+    int counted = stream_arrays_read[kernel] + stream_arrays_written[kernel];
+    return bandwidth * (counted + stream_arrays_written[kernel]) / counted;
+}
+
+/* One pass of a STREAM kernel over n elements */
+void stream_kernel_pass(stream_kernel_t kernel, double* restrict a, double* restrict b,
+                        double* restrict c, size_t n) {
+    switch (kernel) {
+    case STREAM_COPY:
+        for (size_t i = 0; i < n; i++) c[i] = a[i];
+        break;
+    case STREAM_SCALE:
+        for (size_t i = 0; i < n; i++) b[i] = STREAM_SCALAR * c[i];
+        break;
+    case STREAM_ADD:
+        for (size_t i = 0; i < n; i++) c[i] = a[i] + b[i];
+        break;
+    case STREAM_TRIAD:
+        for (size_t i = 0; i < n; i++) a[i] = b[i] + STREAM_SCALAR * c[i];
+        break;
+    default:
+        break;
+    }
+}
+
+/* One thread's STREAM arrays: the per-thread memory block split in three */
+typedef struct {
+    double *a, *b, *c;
+    size_t n;                          // Elements per array
+} stream_arrays_t;
+
+/* Allocate and initialize the arrays; false (nothing to free) on failure */
+bool stream_arrays_alloc(stream_arrays_t* arrays, int thread_id) {
+    size_t n = memory_block_size / (3 * sizeof(double));
+    double *a = NULL, *b = NULL, *c = NULL;
+    if (posix_memalign((void**)&a, 64, n * sizeof(double)) != 0 ||
+        posix_memalign((void**)&b, 64, n * sizeof(double)) != 0 ||
+        posix_memalign((void**)&c, 64, n * sizeof(double)) != 0) {
+        log_message("Thread %d: Memory allocation failed for STREAM test", thread_id);
+        free(a);
+        free(b);
+        free(c);
+        return false;
+    }
+    
+    for (size_t i = 0; i < n; i++) {
+        a[i] = 1.0;
+        b[i] = 2.0;
+        c[i] = 0.0;
+    }
+    *arrays = (stream_arrays_t){a, b, c, n};
+    return true;
+}
+
+void stream_arrays_free(stream_arrays_t* arrays) {
+    free(arrays->a);
+    free(arrays->b);
+    free(arrays->c);
+}
+
+/* Memory Benchmark Implementation 2: STREAM Copy/Scale/Add/Triad over
+ * arrays allocated and initialized before the gate. Returns false when
+ * the arrays fail validation after the run. */
+bool memory_benchmark_impl_stream(int thread_id, const stream_arrays_t* arrays, double deadline,
+                                  double bandwidth[STREAM_NUM_KERNELS]) {
+    verbose_log("Thread %d: Starting STREAM benchmark...", thread_id);
+    
+    size_t n = arrays->n;
+    double *a = arrays->a, *b = arrays->b, *c = arrays->c;
+    
+    double start, end, in_window;
+    double total_bytes[STREAM_NUM_KERNELS] = {0}, total_time[STREAM_NUM_KERNELS] = {0};
+    long long passes[STREAM_NUM_KERNELS] = {1, 1, 1, 1};
+    bool round_complete = false;       // Last round ran all four kernels
+    
+    // Main measurement loop: one round of every kernel per iteration, as STREAM does
+    while (running && monotonic_seconds() < deadline) {
+        int k;
+        for (k = 0; k < STREAM_NUM_KERNELS && running; k++) {
+            double bytes_per_pass = (double)(stream_arrays_read[k] + stream_arrays_written[k]) *
+                                    n * sizeof(double);
+            start = monotonic_seconds();
+            for (long long p = 0; p < passes[k]; p++) {
+                stream_kernel_pass((stream_kernel_t)k, a, b, c, n);
+            }
+            end = monotonic_seconds();
+            
+            in_window = window_fraction(start, end, deadline);
+            total_time[k] += (end - start) * in_window;
+            total_bytes[k] += passes[k] * bytes_per_pass * in_window;
+            passes[k] = calibrate_batch(passes[k], end - start);
+        }
+        round_complete = (k == STREAM_NUM_KERNELS);
+        
+        load_profile_pause();
+    }
+    
+    // After a complete round a = 1, b = s and c = 1 + s (Triad restores a
+    // because s = sqrt(2) - 1), so any drift means a broken kernel. A round
+    // cut short by an interrupt leaves the arrays mid-way and is not checked.
+    bool verified = true;
+    const double expected[3] = {1.0, STREAM_SCALAR, 1.0 + STREAM_SCALAR};
+    const double* arrays_checked[3] = {a, b, c};
+    size_t stride = (n + STREAM_VALIDATE_POINTS - 1) / STREAM_VALIDATE_POINTS;
+    for (size_t i = 0; round_complete && verified && i < n; i += stride) {
+        for (int x = 0; x < 3 && verified; x++) {
+            if (fabs(arrays_checked[x][i] - expected[x]) > 1e-6 * expected[x]) {
+                log_message("Thread %d: STREAM validation failed (%c[%zu] = %f, expected %f)", thread_id,
+                            'a' + x, i, arrays_checked[x][i], expected[x]);
+                verified = false;
+            }
+        }
+    }
+    
+    for (int k = 0; k < STREAM_NUM_KERNELS; k++) {
+        bandwidth[k] = (total_time[k] > 0) ? (total_bytes[k] / (1024 * 1024)) / total_time[k] : 0;
+    }
+    
+    verbose_log("Thread %d: STREAM benchmark completed. Copy: %.2f MB/s, Scale: %.2f MB/s, "
+                "Add: %.2f MB/s, Triad: %.2f MB/s", thread_id,
+                bandwidth[STREAM_COPY], bandwidth[STREAM_SCALE], bandwidth[STREAM_ADD], bandwidth[STREAM_TRIAD]);
+    return verified;
+}
+
+/* CPU cache hierarchy as described by sysfs for cpu0 */
+#define MAX_CACHE_LEVELS 8
+
+typedef struct {
+    int level;                         // 1, 2, 3...
+    char type[16];                     // "Data", "Instruction" or "Unified"
+    size_t size;                       // Bytes
+    int line_size;                     // Coherency line size in bytes
+    int shared_cpus;                   // Logical CPUs sharing this cache
+} cache_level_t;
+
+cache_level_t cache_levels[MAX_CACHE_LEVELS];
+int num_cache_levels = 0;
+
+/* Read one line of a sysfs attribute into buf; false if it does not exist */
+bool read_sysfs_string(const char* path, char* buf, size_t len) {
+    FILE* file = fopen(path, "r");
+    if (!file) return false;
+    bool ok = fgets(buf, (int)len, file) != NULL;
+    fclose(file);
+    if (ok) buf[strcspn(buf, "\n")] = '\0';
+    return ok;
+}
+
+/* Parse a sysfs CPU list such as "0-3,8-11" into `set` (may be NULL);
+ * returns the number of CPUs listed */
+int parse_cpu_list(const char* list, cpu_set_t* set) {
+    int count = 0;
+    const char* p = list;
+    if (set) CPU_ZERO(set);
+    while (*p) {
+        char* end;
+        long first = strtol(p, &end, 10);
+        if (end == p) break;
+        long last = first;
+        if (*end == '-') last = strtol(end + 1, &end, 10);
+        for (long cpu = first; set && cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+            CPU_SET((int)cpu, set);
+        }
+        count += (int)(last - first + 1);
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return count;
+}
+
+/* Count CPUs in a sysfs list such as "0-3,8-11" */
+int count_cpu_list(const char* list) {
+    return parse_cpu_list(list, NULL);
+}
+
+/* Parse a sysfs cache size such as "48K" or "32M" */
+size_t parse_cache_size(const char* text) {
+    char* end;
+    size_t value = (size_t)strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k') value *= 1024;
+    else if (*end == 'M' || *end == 'm') value *= 1024 * 1024;
+    else if (*end == 'G' || *end == 'g') value *= 1024 * 1024 * 1024;
+    return value;
+}
+
+/* Load the data/unified caches of cpu0 from
+ * /sys/devices/system/cpu/cpu0/cache/index*, ordered by level */
+int read_cache_hierarchy(void) {
+    num_cache_levels = 0;
+    
+    for (int index = 0; index < 16 && num_cache_levels < MAX_CACHE_LEVELS; index++) {
+        char path[128], value[256];
+        cache_level_t cache = {0};
+        
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+        if (!read_sysfs_string(path, cache.type, sizeof(cache.type))) break;
+        if (strcmp(cache.type, "Instruction") == 0) continue;
+        
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+        if (read_sysfs_string(path, value, sizeof(value))) cache.level = atoi(value);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+        if (read_sysfs_string(path, value, sizeof(value))) cache.size = parse_cache_size(value);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", index);
+        if (read_sysfs_string(path, value, sizeof(value))) cache.line_size = atoi(value);
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/shared_cpu_list", index);
+        cache.shared_cpus = read_sysfs_string(path, value, sizeof(value)) ? count_cpu_list(value) : 1;
+        
+        if (cache.level <= 0 || cache.size == 0) continue;
+        
+        // Keep the list sorted by level
+        int pos = num_cache_levels;
+        while (pos > 0 && cache_levels[pos - 1].level > cache.level) {
+            cache_levels[pos] = cache_levels[pos - 1];
+            pos--;
+        }
+        cache_levels[pos] = cache;
+        num_cache_levels++;
+    }
+    
+    return num_cache_levels;
+}
+
+/* Logical CPU topology from /sys/devices/system/cpu, used to place the
+ * benchmark threads under an affinity policy */
+#define MAX_TOPOLOGY_CPUS 1024
+
+typedef struct {
+    int cpu;                           // Logical CPU number
+    int package;                       // physical_package_id (socket)
+    int core;                          // core_id within the package
+    int core_rank;                     // Index of the core within its package
+    int sibling;                       // Index among the SMT threads of the core
+} cpu_topology_t;
+
+cpu_topology_t cpu_topology[MAX_TOPOLOGY_CPUS];
+int num_topology_cpus = 0;
+int affinity_cpus[MAX_TOPOLOGY_CPUS];           // Phase slot k runs on affinity_cpus[k % n]
+int num_affinity_cpus = 0;
+
+/* Package, then core, then CPU number: SMT siblings end up adjacent */
+int compare_topology_compact(const void* a, const void* b) {
+    const cpu_topology_t* x = (const cpu_topology_t*)a;
+    const cpu_topology_t* y = (const cpu_topology_t*)b;
+    if (x->package != y->package) return x->package - y->package;
+    if (x->core != y->core) return x->core - y->core;
+    return x->cpu - y->cpu;
+}
+
+/* First SMT thread of every core before any second one, alternating sockets */
+int compare_topology_scatter(const void* a, const void* b) {
+    const cpu_topology_t* x = (const cpu_topology_t*)a;
+    const cpu_topology_t* y = (const cpu_topology_t*)b;
+    if (x->sibling != y->sibling) return x->sibling - y->sibling;
+    if (x->core_rank != y->core_rank) return x->core_rank - y->core_rank;
+    return x->package - y->package;
+}
+
+/* Load the online CPUs in compact order; returns the CPU count */
+int read_cpu_topology(void) {
+    char list[1024];
+    cpu_set_t online;
+    num_topology_cpus = 0;
+    if (!read_sysfs_string("/sys/devices/system/cpu/online", list, sizeof(list))) return 0;
+    parse_cpu_list(list, &online);
+    
+    for (int cpu = 0; cpu < CPU_SETSIZE && num_topology_cpus < MAX_TOPOLOGY_CPUS; cpu++) {
+        if (!CPU_ISSET(cpu, &online)) continue;
+        
+        char path[128], value[32];
+        cpu_topology_t* entry = &cpu_topology[num_topology_cpus++];
+        entry->cpu = cpu;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", cpu);
+        entry->package = read_sysfs_string(path, value, sizeof(value)) ? atoi(value) : 0;
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", cpu);
+        entry->core = read_sysfs_string(path, value, sizeof(value)) ? atoi(value) : cpu;
+    }
+    
+    qsort(cpu_topology, num_topology_cpus, sizeof(cpu_topology_t), compare_topology_compact);
+    for (int i = 0; i < num_topology_cpus; i++) {
+        cpu_topology_t* entry = &cpu_topology[i];
+        const cpu_topology_t* prev = (i > 0) ? &cpu_topology[i - 1] : NULL;
+        bool same_package = prev && prev->package == entry->package;
+        bool same_core = same_package && prev->core == entry->core;
+        entry->sibling = same_core ? prev->sibling + 1 : 0;
+        entry->core_rank = !same_package ? 0 : same_core ? prev->core_rank : prev->core_rank + 1;
+    }
+    return num_topology_cpus;
+}
+
+/* Fill affinity_cpus for the policy; returns the number of CPUs in it */
+int plan_affinity(affinity_policy_t policy, const char* cpu_list) {
+    num_affinity_cpus = 0;
+    if (policy == AFFINITY_NONE || read_cpu_topology() == 0) return 0;
+    
+    if (policy == AFFINITY_LIST) {
+        cpu_set_t wanted;
+        parse_cpu_list(cpu_list, &wanted);
+        for (int cpu = 0; cpu < CPU_SETSIZE && num_affinity_cpus < MAX_TOPOLOGY_CPUS; cpu++) {
+            if (!CPU_ISSET(cpu, &wanted)) continue;
+            bool online = false;
+            for (int i = 0; i < num_topology_cpus; i++) online |= (cpu_topology[i].cpu == cpu);
+            if (online) {
+                affinity_cpus[num_affinity_cpus++] = cpu;
+            } else {
+                log_message("CPU %d in the affinity list is not online; skipped", cpu);
+            }
+        }
+        return num_affinity_cpus;
+    }
+    
+    cpu_topology_t order[MAX_TOPOLOGY_CPUS];
+    memcpy(order, cpu_topology, num_topology_cpus * sizeof(cpu_topology_t));
+    if (policy == AFFINITY_SCATTER) {
+        qsort(order, num_topology_cpus, sizeof(cpu_topology_t), compare_topology_scatter);
+    }
+    for (int i = 0; i < num_topology_cpus; i++) {
+        if (policy == AFFINITY_PHYSICAL && order[i].sibling != 0) continue;
+        affinity_cpus[num_affinity_cpus++] = order[i].cpu;
+    }
+    return num_affinity_cpus;
+}
+
+/* Creation attributes that pin phase slot `slot` under the affinity policy,
+ * or NULL for default attributes when no policy is active */
+pthread_attr_t* affinity_thread_attr(pthread_attr_t* attr, int slot) {
+    if (num_affinity_cpus == 0) return NULL;
+    
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(affinity_cpus[slot % num_affinity_cpus], &set);
+    pthread_attr_init(attr);
+    if (pthread_attr_setaffinity_np(attr, sizeof(set), &set) != 0) {
+        pthread_attr_destroy(attr);
+        return NULL;
+    }
+    return attr;
+}
+
+/* Memory latency: a pointer chase through a randomly permuted cyclic list
+ * of cache-line sized nodes. Each load depends on the previous one, so the
+ * time per hop is the load-to-use latency of whichever level of the
+ * hierarchy the working set fits in; the random order defeats the
+ * hardware prefetchers. */
+#define LATENCY_MIN_WORKING_SET (4 * 1024)              // 4 KiB
+#define LATENCY_LLC_MULTIPLE 4                          // Sweep up to 4x the last-level cache
+#define LATENCY_DEFAULT_LLC (32 * 1024 * 1024)          // When the LLC size is unknown
+#define LATENCY_MAX_SIZES 32
+
+typedef struct latency_node {
+    struct latency_node* next;
+    char pad[64 - sizeof(struct latency_node*)];
+} latency_node_t;
+
+size_t latency_sizes[LATENCY_MAX_SIZES];        // Working sets of the sweep in bytes
+thread_stats_t latency_stats[LATENCY_MAX_SIZES];
+int latency_num_sizes = 0;
+size_t latency_working_set = 0;                 // Size currently being measured
+latency_histogram_t latency_histograms[LATENCY_MAX_SIZES];  // ps per load, one sample per batch
+latency_histogram_t* latency_histogram = NULL;  // Histogram of the size being measured
+
+/* Size of the last-level cache: sysfs first, then the C library, then a
+ * default when neither knows */
+size_t detect_llc_size(void) {
+    if (num_cache_levels == 0) read_cache_hierarchy();
+    if (num_cache_levels > 0) return cache_levels[num_cache_levels - 1].size;
+    
+    long llc = 0;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc <= 0) llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    return (llc > 0) ? (size_t)llc : LATENCY_DEFAULT_LLC;
+}
+
+/* Power-of-two working sets from 4 KiB to LATENCY_LLC_MULTIPLE x LLC */
+void latency_plan_sizes(size_t llc_size) {
+    latency_num_sizes = 0;
+    for (size_t size = LATENCY_MIN_WORKING_SET;
+         size <= llc_size * LATENCY_LLC_MULTIPLE && latency_num_sizes < LATENCY_MAX_SIZES;
+         size *= 2) {
+        latency_sizes[latency_num_sizes++] = size;
+    }
+}
+
+/* Link `count` nodes into a single random cycle (Sattolo's algorithm) */
+latency_node_t* latency_build_chain(latency_node_t* nodes, size_t count, uint64_t seed) {
+    size_t* order = malloc(count * sizeof(size_t));
+    if (!order) return NULL;
+    
+    for (size_t i = 0; i < count; i++) order[i] = i;
+    for (size_t i = count - 1; i > 0; i--) {
+        size_t j = random_next(&seed) % i;      // j < i keeps it one cycle
+        size_t tmp = order[i];
+        order[i] = order[j];
+        order[j] = tmp;
+    }
+    for (size_t i = 0; i < count; i++) {
+        nodes[order[i]].next = &nodes[order[(i + 1) % count]];
+    }
+    
+    latency_node_t* head = &nodes[order[0]];
+    free(order);
+    return head;
+}
+
+/* Follow `hops` links starting at p; returns where the chase stopped */
+latency_node_t* latency_chase(latency_node_t* p, long long hops) {
+    long long i = 0;
+    for (; i + 16 <= hops; i += 16) {
+        p = p->next; p = p->next; p = p->next; p = p->next;
+        p = p->next; p = p->next; p = p->next; p = p->next;
+        p = p->next; p = p->next; p = p->next; p = p->next;
+        p = p->next; p = p->next; p = p->next; p = p->next;
+    }
+    for (; i < hops; i++) p = p->next;
+    return p;
+}
+
+/* Build the chain for one working set and return its nodes (NULL on failure) */
+latency_node_t* memory_latency_prepare(int thread_id, size_t working_set, latency_node_t** head) {
+    size_t count = working_set / sizeof(latency_node_t);
+    latency_node_t* nodes = NULL;
+    if (count < 2 || posix_memalign((void**)&nodes, 64, count * sizeof(latency_node_t)) != 0) {
+        log_message("Thread %d: Memory allocation failed for %zu KB latency test",
+                    thread_id, working_set / 1024);
+        return NULL;
+    }
+    
+    *head = latency_build_chain(nodes, count, 0x5DEECE66DULL + working_set + thread_id);
+    if (!*head) {
+        free(nodes);
+        return NULL;
+    }
+    
+    // Warm up: one full lap brings the working set into the hierarchy
+    *head = latency_chase(*head, (long long)count);
+    return nodes;
+}
+
+/* Memory Benchmark Implementation 3: Pointer-chase latency in ns per load.
+ * When `histogram` is given, the per-load latency of every batch that ends
+ * inside the window is recorded in picoseconds. */
+double memory_benchmark_impl_latency(int thread_id, latency_node_t* head, double deadline,
+                                     latency_histogram_t* histogram) {
+    double start, end;
+    double total_hops = 0, total_time = 0;
+    long long hops = 100000;
+    latency_node_t* p = head;
+    
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
+        p = latency_chase(p, hops);
+        end = monotonic_seconds();
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_hops += hops * in_window;
+        total_time += (end - start) * in_window;
+        if (histogram && in_window == 1.0) {
+            histogram_record(histogram, (uint64_t)((end - start) * 1e12 / hops));
+        }
+        hops = calibrate_batch(hops, end - start);
+        
+        load_profile_pause();
+    }
+    
+    // Make the final position observable so the chase cannot be elided
+    if (p == NULL) log_message("Thread %d: latency chain broken", thread_id);
+    
+    return (total_hops > 0) ? total_time * BILLION / total_hops : 0;
+}
+
+/* Cache hierarchy bandwidth sweep: the full-width read kernel and the
+ * regular write kernel over geometrically growing per-thread buffers, two
+ * points per octave, from 4 KiB to 4x the last-level cache. */
+#define CACHE_SWEEP_MAX_SIZES 64
+#define CACHE_SWEEP_MIN_SIZE (4 * 1024)
+#define CACHE_SWEEP_LLC_MULTIPLE 4
+#define CACHE_SWEEP_DROP_RATIO 0.75                     // Read drop that marks a level boundary
+
+size_t cache_sweep_sizes[CACHE_SWEEP_MAX_SIZES];
+thread_stats_t cache_sweep_read_stats[CACHE_SWEEP_MAX_SIZES];
+thread_stats_t cache_sweep_write_stats[CACHE_SWEEP_MAX_SIZES];
+int cache_sweep_num_sizes = 0;
+size_t cache_sweep_size = 0;                    // Size currently being measured
+
+/* Sizes 4K, 6K, 8K, 12K, 16K... up to CACHE_SWEEP_LLC_MULTIPLE x LLC */
+void cache_sweep_plan_sizes(size_t llc_size) {
+    cache_sweep_num_sizes = 0;
+    for (size_t size = CACHE_SWEEP_MIN_SIZE;
+         size <= llc_size * CACHE_SWEEP_LLC_MULTIPLE && cache_sweep_num_sizes + 1 < CACHE_SWEEP_MAX_SIZES;
+         size *= 2) {
+        cache_sweep_sizes[cache_sweep_num_sizes++] = size;
+        cache_sweep_sizes[cache_sweep_num_sizes++] = size + size / 2;
+    }
+}
+
+/* Capacity of one cache level available to each sweep thread: a cache
+ * shared by several CPUs is split between the sweep threads that can land
+ * on it, at most one per sharing CPU */
+size_t cache_share_per_thread(const cache_level_t* cache) {
+    int sharers = (num_threads < cache->shared_cpus) ? num_threads : cache->shared_cpus;
+    return cache->size / (sharers > 1 ? (size_t)sharers : 1);
+}
+
+/* Median of the summed read or write bandwidth over sweep points whose
+ * size lies in (low, high]; 0 when no point falls in the range */
+double cache_sweep_plateau(const thread_stats_t* stats, size_t low, size_t high) {
+    double values[CACHE_SWEEP_MAX_SIZES];
+    int count = 0;
+    
+    for (int s = 0; s < cache_sweep_num_sizes; s++) {
+        if (cache_sweep_sizes[s] > low && cache_sweep_sizes[s] <= high) {
+            int pos = count++;
+            while (pos > 0 && values[pos - 1] > stats[s].sum) {
+                values[pos] = values[pos - 1];
+                pos--;
+            }
+            values[pos] = stats[s].sum;
+        }
+    }
+    if (count == 0) return 0;
+    return (count % 2) ? values[count / 2] : 0.5 * (values[count / 2 - 1] + values[count / 2]);
+}
+
+/* Memory Benchmark Implementation 4: bandwidth for one sweep buffer size */
+void memory_benchmark_impl_sweep(int thread_id, char* buffer, size_t buffer_size, double deadline,
+                                 double *read_bw, double *write_bw) {
+    memory_read_impl_t read_impl = select_memory_read_impl();
+    double start, end, in_window;
+    double total_read_bytes = 0, total_read_time = 0;
+    double total_write_bytes = 0, total_write_time = 0;
+    
+    // Start near one slice's worth of passes so tiny buffers calibrate quickly
+    long long initial = (long long)(64 * 1024 * 1024 / buffer_size);
+    long long write_passes = initial > 0 ? initial : 1, read_passes = write_passes;
+    uint64_t checksum = 0;
+    
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
+        for (long long iter = 0; iter < write_passes && running; iter++) {
+            memset(buffer, (int)((iter + thread_id) & 0xFF), buffer_size);
+        }
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, deadline);
+        total_write_time += (end - start) * in_window;
+        total_write_bytes += (double)write_passes * buffer_size * in_window;
+        write_passes = calibrate_batch(write_passes, end - start);
+        
+        start = monotonic_seconds();
+        for (long long iter = 0; iter < read_passes && running; iter++) {
+            checksum ^= read_impl.kernel(buffer, buffer_size);
+        }
+        end = monotonic_seconds();
+        in_window = window_fraction(start, end, deadline);
+        total_read_time += (end - start) * in_window;
+        total_read_bytes += (double)read_passes * buffer_size * in_window;
+        read_passes = calibrate_batch(read_passes, end - start);
+        
+        load_profile_pause();
+    }
+    
+    // Ensure checksum is used
+    if (checksum == 1) buffer[0] = 0;
+    
+    *read_bw = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
+    *write_bw = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
+}
+
+/* NUMA topology from /sys/devices/system/node. Memory policies are set
+ * with the raw mbind/set_mempolicy syscalls so no libnuma is needed. */
+#define NUMA_MAX_NODES 8
+#define NUMA_MPOL_BIND 2                                // MPOL_BIND from <linux/mempolicy.h>
+#define NUMA_MPOL_MF_STRICT (1 << 0)
+#define NUMA_MPOL_MF_MOVE (1 << 1)
+
+typedef struct {
+    int id;                            // Kernel node number
+    int cpu_count;                     // 0 for memory-only nodes
+    cpu_set_t cpus;
+} numa_node_t;
+
+numa_node_t numa_nodes[NUMA_MAX_NODES];
+int num_numa_nodes = 0;
+int numa_cpu_node = 0;                          // Matrix cell currently being measured
+int numa_mem_node = 0;                          // (indices into numa_nodes)
+thread_stats_t numa_read_stats[NUMA_MAX_NODES][NUMA_MAX_NODES];
+thread_stats_t numa_write_stats[NUMA_MAX_NODES][NUMA_MAX_NODES];
+double numa_latency_ns[NUMA_MAX_NODES][NUMA_MAX_NODES];
+bool numa_measured[NUMA_MAX_NODES][NUMA_MAX_NODES];    // Cell ran with its memory actually bound
+
+/* Load the online nodes and their CPUs; returns the node count (0 when
+ * the kernel exposes no NUMA topology) */
+int read_numa_topology(void) {
+    char list[256];
+    num_numa_nodes = 0;
+    if (!read_sysfs_string("/sys/devices/system/node/online", list, sizeof(list))) return 0;
+    
+    // The online list has the same "0-1,4" syntax as a CPU list
+    cpu_set_t online;
+    parse_cpu_list(list, &online);
+    for (int id = 0; id < (int)(8 * sizeof(unsigned long)) && num_numa_nodes < NUMA_MAX_NODES; id++) {
+        if (!CPU_ISSET(id, &online)) continue;
+        
+        char path[128], cpus[1024];
+        numa_node_t* node = &numa_nodes[num_numa_nodes++];
+        node->id = id;
+        snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", id);
+        if (read_sysfs_string(path, cpus, sizeof(cpus))) {
+            node->cpu_count = parse_cpu_list(cpus, &node->cpus);
+        } else {
+            node->cpu_count = 0;
+            CPU_ZERO(&node->cpus);
+        }
+    }
+    return num_numa_nodes;
+}
+
+/* Pin the calling thread to the `index`-th CPU of a node (wrapping) */
+bool numa_pin_thread(const numa_node_t* node, int index) {
+    if (node->cpu_count == 0) return false;
+    int wanted = index % node->cpu_count;
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (!CPU_ISSET(cpu, &node->cpus)) continue;
+        if (wanted-- == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+        }
+    }
+    return false;
+}
+
+/* Bind all future allocations of the calling thread to one node */
+bool numa_bind_thread_memory(const numa_node_t* node) {
+    unsigned long mask = 1UL << node->id;
+    return syscall(SYS_set_mempolicy, NUMA_MPOL_BIND, &mask, 8 * sizeof(mask) + 1) == 0;
+}
+
+/* Anonymous mapping whose pages are bound to one node before first touch;
+ * if the kernel refuses the policy the buffer is still returned, unbound */
+void* numa_alloc_on_node(size_t size, const numa_node_t* node, bool* bound) {
+    void* buffer = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (buffer == MAP_FAILED) return NULL;
+    
+    unsigned long mask = 1UL << node->id;
+    *bound = syscall(SYS_mbind, buffer, size, NUMA_MPOL_BIND, &mask, 8 * sizeof(mask) + 1,
+                     NUMA_MPOL_MF_STRICT | NUMA_MPOL_MF_MOVE) == 0;
+    return buffer;
+}
+
+/* Spread memory threads over the nodes that have CPUs: thread k runs on
+ * the (k mod nodes)-th such node and allocates only from it */
+void numa_place_memory_thread(int index) {
+    int cpu_nodes[NUMA_MAX_NODES], count = 0;
+    for (int n = 0; n < num_numa_nodes; n++) {
+        if (numa_nodes[n].cpu_count > 0) cpu_nodes[count++] = n;
+    }
+    if (count == 0) return;
+    
+    const numa_node_t* node = &numa_nodes[cpu_nodes[index % count]];
+    if (!numa_pin_thread(node, index / count) || !numa_bind_thread_memory(node)) {
+        verbose_log("Memory thread %d: could not pin/bind to NUMA node %d", index, node->id);
+    }
+}
+
+/* Disk Benchmark Implementation 1: Throughput and IOPS */
+void disk_benchmark_impl_throughput(int thread_id, double deadline, const char* filename,
+                                 double *read_tp, double *write_tp, double *iops) {
+    verbose_log("Thread %d: Starting disk throughput benchmark...", thread_id);
+    
+    double start, end, in_window;
+    
+    // Allocate buffer for disk operations
+    char* buffer = (char*)malloc(file_size);
+    if (!buffer) {
+        log_message("Thread %d: Memory allocation failed for disk test", thread_id);
+        *read_tp = *write_tp = *iops = 0;
+        return;
+    }
+    
+    // Initialize buffer with pattern data
+    for (size_t i = 0; i < file_size; i++) {
+        buffer[i] = (char)((i + thread_id) % 256);
+    }
+    
+    double total_read_bytes = 0, total_read_time = 0;
+    double total_write_bytes = 0, total_write_time = 0;
+    double total_seek_ops = 0, total_seek_time = 0;
+    long long iops_iterations = 100;
+    uint64_t rng = 0x2545F4914F6CDD1DULL ^ (uint64_t)thread_id;
+    
+    // Main measurement loop
+    while (running && monotonic_seconds() < deadline) {
+        // WRITE benchmark
+        start = monotonic_seconds();
+        
+        FILE* file = fopen(filename, "wb");
+        if (file) {
+            size_t written = fwrite(buffer, 1, file_size, file);
+            fclose(file);
+            
+            if (written > 0) {
+                end = monotonic_seconds();
+                in_window = window_fraction(start, end, deadline);
+                total_write_time += (end - start) * in_window;
+                total_write_bytes += written * in_window;
+            }
+        }
+        
+        // READ benchmark
+        start = monotonic_seconds();
+        
+        file = fopen(filename, "rb");
+        if (file) {
+            size_t bytes_read = fread(buffer, 1, file_size, file);
+            fclose(file);
+            
+            if (bytes_read > 0) {
+                end = monotonic_seconds();
+                in_window = window_fraction(start, end, deadline);
+                total_read_time += (end - start) * in_window;
+                total_read_bytes += bytes_read * in_window;
+            }
+        }
+        
+        // IOPS (Random access) benchmark
+        start = monotonic_seconds();
+        
+        file = fopen(filename, "r+b");
+        if (file) {
+            char small_buf[512];
+            for (long long i = 0; i < iops_iterations && running; i++) {
+                long pos = (long)(random_next(&rng) % (file_size - sizeof(small_buf)));
+                fseek(file, pos, SEEK_SET);
+                fread(small_buf, 1, sizeof(small_buf), file);
+            }
+            fclose(file);
+            
+            end = monotonic_seconds();
+            in_window = window_fraction(start, end, deadline);
+            total_seek_time += (end - start) * in_window;
+            total_seek_ops += iops_iterations * in_window;
+            iops_iterations = calibrate_batch(iops_iterations, end - start);
+        }
+        
+        load_profile_pause();
+    }
+    
+    // Calculate metrics
+    *read_tp = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
+    *write_tp = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
+    *iops = (total_seek_time > 0) ? total_seek_ops / total_seek_time : 0;
+    
+    verbose_log("Thread %d: Disk benchmark completed. Read: %.2f MB/s, Write: %.2f MB/s, IOPS: %.2f",
+               thread_id, *read_tp, *write_tp, *iops);
+    
+    free(buffer);
+}
+
+/* Direct I/O: O_DIRECT transfers move between the user buffer and the
+ * device without the page cache. Buffer addresses, offsets and lengths
+ * must be multiples of the device's logical block size. */
+#define DIRECT_IO_DEFAULT_ALIGNMENT 4096
+
+/* Logical block size of the device behind an open file, from
+ * /sys/dev/block/MAJOR:MINOR (a partition uses its parent disk's queue) */
+size_t device_logical_block_size(int fd) {
+    struct stat st;
+    char path[128], value[32];
+    if (fstat(fd, &st) != 0) return DIRECT_IO_DEFAULT_ALIGNMENT;
+    
+    snprintf(path, sizeof(path), "/sys/dev/block/%u:%u/queue/logical_block_size",
+             major(st.st_dev), minor(st.st_dev));
+    bool found = read_sysfs_string(path, value, sizeof(value));
+    if (!found) {
+        snprintf(path, sizeof(path), "/sys/dev/block/%u:%u/../queue/logical_block_size",
+                 major(st.st_dev), minor(st.st_dev));
+        found = read_sysfs_string(path, value, sizeof(value));
+    }
+    
+    long size = found ? atol(value) : 0;
+    bool power_of_two = size >= 512 && (size & (size - 1)) == 0;
+    return power_of_two ? (size_t)size : DIRECT_IO_DEFAULT_ALIGNMENT;
+}
+
+/* Disk Benchmark Implementation 2: O_DIRECT sequential throughput.
+ * Each pass writes the whole file in io_block_size requests and
+ * fdatasyncs it, then reads it back the same way. Returns false when the
+ * filesystem refuses O_DIRECT. */
+bool disk_benchmark_impl_direct(int thread_id, double deadline, const char* filename,
+                                double *read_tp, double *write_tp) {
+    *read_tp = *write_tp = 0;
+    int fd = open(filename, O_RDWR | O_CREAT | O_DIRECT, 0644);
+    if (fd < 0) {
+        log_message("Thread %d: O_DIRECT open of %s failed: %s", thread_id, filename, strerror(errno));
+        return false;
+    }
+    
+    // Requests and the file are whole multiples of the logical block size
+    size_t alignment = device_logical_block_size(fd);
+    size_t block = (io_block_size + alignment - 1) / alignment * alignment;
+    size_t transfer = (file_size / block) * block;
+    if (transfer == 0) transfer = block;
+    verbose_log("Thread %d: O_DIRECT with %zu B alignment, %zu KB requests, %zu KB per pass",
+                thread_id, alignment, block / 1024, transfer / 1024);
+    
+    char* buffer = NULL;
+    if (posix_memalign((void**)&buffer, alignment, block) != 0) {
+        log_message("Thread %d: Memory allocation failed for O_DIRECT test", thread_id);
+        close(fd);
+        return false;
+    }
+    for (size_t i = 0; i < block; i++) {
+        buffer[i] = (char)((i + thread_id) % 256);
+    }
+    
+    double start, end, in_window;
+    double total_read_bytes = 0, total_read_time = 0;
+    double total_write_bytes = 0, total_write_time = 0;
+    bool ok = true;
+    
+    // Main measurement loop
+    while (ok && running && monotonic_seconds() < deadline) {
+        // WRITE benchmark: durable once fdatasync returns
+        start = monotonic_seconds();
+        for (size_t offset = 0; offset < transfer && ok; offset += block) {
+            ok = pwrite(fd, buffer, block, (off_t)offset) == (ssize_t)block;
+        }
+        ok = ok && fdatasync(fd) == 0;
+        end = monotonic_seconds();
+        if (!ok) break;
+        in_window = window_fraction(start, end, deadline);
+        total_write_time += (end - start) * in_window;
+        total_write_bytes += transfer * in_window;
+        
+        // READ benchmark
+        start = monotonic_seconds();
+        for (size_t offset = 0; offset < transfer && ok; offset += block) {
+            ok = pread(fd, buffer, block, (off_t)offset) == (ssize_t)block;
+        }
+        end = monotonic_seconds();
+        if (!ok) break;
+        in_window = window_fraction(start, end, deadline);
+        total_read_time += (end - start) * in_window;
+        total_read_bytes += transfer * in_window;
+        
+        load_profile_pause();
+    }
+    
+    if (!ok) {
+        log_message("Thread %d: O_DIRECT transfer failed: %s", thread_id, strerror(errno));
+    }
+    close(fd);
+    free(buffer);
+    
+    *read_tp = (total_read_time > 0) ? (total_read_bytes / (1024*1024)) / total_read_time : 0;
+    *write_tp = (total_write_time > 0) ? (total_write_bytes / (1024*1024)) / total_write_time : 0;
+    
+    verbose_log("Thread %d: O_DIRECT benchmark completed. Read: %.2f MB/s, Write: %.2f MB/s",
+                thread_id, *read_tp, *write_tp);
+    return ok;
+}
+
+/* io_uring engine on the raw io_uring_setup/io_uring_enter/io_uring_register
+ * syscalls (only the kernel UAPI header, no liburing). Each thread keeps
+ * uring_queue_depth requests in flight against its own O_DIRECT file. */
+#define URING_MAX_QUEUE_DEPTHS 8
+#define URING_SQPOLL_IDLE_MS 2000
+
+typedef enum {
+    URING_SEQ_READ,
+    URING_RAND_READ,
+    URING_SEQ_WRITE,
+    URING_RAND_WRITE,
+    URING_NUM_WORKLOADS
+} uring_workload_t;
+
+const char* const uring_workload_names[URING_NUM_WORKLOADS] = {
+    "seq read", "rand read", "seq write", "rand write"};
+
+int uring_queue_depths[URING_MAX_QUEUE_DEPTHS] = {1, 8, 32};
+int uring_num_queue_depths = 3;
+thread_stats_t uring_throughput_stats[URING_NUM_WORKLOADS][URING_MAX_QUEUE_DEPTHS];
+thread_stats_t uring_iops_stats[URING_NUM_WORKLOADS][URING_MAX_QUEUE_DEPTHS];
+uring_workload_t uring_workload = URING_SEQ_READ;  // Cell currently being measured
+int uring_queue_depth = 1;
+
+#ifdef HAVE_IO_URING
+typedef struct {
+    int fd;
+    bool sqpoll;
+    unsigned *sq_head, *sq_tail, *sq_mask, *sq_flags, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe* sqes;
+    struct io_uring_cqe* cqes;
+    void* sq_ring;
+    void* cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+} uring_t;
+
+/* Create a ring with room for `entries` requests and map its queues */
+bool uring_setup(uring_t* ring, unsigned entries, bool sqpoll) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    memset(ring, 0, sizeof(*ring));
+    if (sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = URING_SQPOLL_IDLE_MS;
+    }
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0) return false;
+    ring->sqpoll = sqpoll;
+    
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+    bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap && ring->cq_ring_size > ring->sq_ring_size) ring->sq_ring_size = ring->cq_ring_size;
+    
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_ring = single_mmap ? ring->sq_ring
+                                : mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                                       MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        // Unmap the regions that did map, the shared ring only once
+        if (ring->sqes != MAP_FAILED) munmap(ring->sqes, ring->sqes_size);
+        if (ring->cq_ring != MAP_FAILED && ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+        if (ring->sq_ring != MAP_FAILED) munmap(ring->sq_ring, ring->sq_ring_size);
+        close(ring->fd);
+        return false;
+    }
+    
+    char* sq = (char*)ring->sq_ring;
+    char* cq = (char*)ring->cq_ring;
+    ring->sq_head = (unsigned*)(sq + params.sq_off.head);
+    ring->sq_tail = (unsigned*)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned*)(sq + params.sq_off.ring_mask);
+    ring->sq_flags = (unsigned*)(sq + params.sq_off.flags);
+    ring->sq_array = (unsigned*)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned*)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned*)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned*)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cq + params.cq_off.cqes);
+    return true;
+}
+
+void uring_close(uring_t* ring) {
+    munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring) munmap(ring->cq_ring, ring->cq_ring_size);
+    munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+/* Next free submission entry, zeroed; the caller fills it and calls
+ * uring_push() */
+struct io_uring_sqe* uring_next_sqe(uring_t* ring) {
+    unsigned tail = *ring->sq_tail;
+    struct io_uring_sqe* sqe = &ring->sqes[tail & *ring->sq_mask];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+/* Publish the entry returned by uring_next_sqe() to the kernel */
+void uring_push(uring_t* ring) {
+    unsigned tail = *ring->sq_tail;
+    ring->sq_array[tail & *ring->sq_mask] = tail & *ring->sq_mask;
+    __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+/* Submit `to_submit` pushed entries and wait for at least `wait_nr`
+ * completions. With SQPOLL the kernel thread picks up submissions itself
+ * and only needs a wakeup once it has gone idle. */
+int uring_enter(uring_t* ring, unsigned to_submit, unsigned wait_nr) {
+    unsigned flags = wait_nr ? IORING_ENTER_GETEVENTS : 0;
+    if (ring->sqpoll) {
+        // Full barrier between publishing sq_tail and reading sq_flags (liburing's
+        // io_uring_smp_mb): otherwise the load can pass the store and an idle SQ
+        // thread is never woken for the new entries
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(ring->sq_flags, __ATOMIC_ACQUIRE) & IORING_SQ_NEED_WAKEUP) {
+            flags |= IORING_ENTER_SQ_WAKEUP;
+        }
+        to_submit = 0;
+        if (flags == 0) return 0;
+    }
+    int rc;
+    do {
+        rc = (int)syscall(__NR_io_uring_enter, ring->fd, to_submit, wait_nr, flags, NULL, 0);
+    } while (rc < 0 && errno == EINTR);
+    return rc;
+}
+
+/* Oldest unconsumed completion, or NULL when the queue is empty */
+struct io_uring_cqe* uring_peek_cqe(uring_t* ring) {
+    unsigned head = *ring->cq_head;
+    if (head == __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE)) return NULL;
+    return &ring->cqes[head & *ring->cq_mask];
+}
+
+void uring_cqe_seen(uring_t* ring) {
+    __atomic_store_n(ring->cq_head, *ring->cq_head + 1, __ATOMIC_RELEASE);
+}
+
+/* Queue one request for slot `slot`: its buffer, at `offset` */
+void uring_queue_io(uring_t* ring, int fd, bool fixed, bool write, char* buffer,
+                    size_t length, off_t offset, int slot) {
+    struct io_uring_sqe* sqe = uring_next_sqe(ring);
+    if (fixed) {
+        sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->fd = 0;                                    // Index into the registered files
+        sqe->flags = IOSQE_FIXED_FILE;
+        sqe->buf_index = (unsigned short)slot;
+    } else {
+        sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+        sqe->fd = fd;
+    }
+    sqe->addr = (unsigned long)buffer;
+    sqe->len = (unsigned)length;
+    sqe->off = (unsigned long long)offset;
+    sqe->user_data = (unsigned long long)slot;
+    uring_push(ring);
+}
+#endif
+
+/* Open a per-thread data file for direct block I/O with extra open
+ * `flags`; falls back to buffered I/O when the filesystem refuses O_DIRECT */
+int disk_open_block_file(int thread_id, const char* filename, int flags, bool* direct) {
+    *direct = true;
+    int fd = open(filename, O_RDWR | O_CREAT | O_DIRECT | flags, 0644);
+    if (fd < 0) {
+        *direct = false;
+        fd = open(filename, O_RDWR | O_CREAT | flags, 0644);
+        if (fd >= 0) verbose_log("Thread %d: O_DIRECT unavailable for %s, using buffered I/O", thread_id, filename);
+    }
+    return fd;
+}
+
+/* Make the file at least `length` bytes (a multiple of 4 KiB) of real
+ * data. The extents are reserved with fallocate first, so a full disk
+ * fails here rather than mid-measurement, but they are still written:
+ * unwritten extents read back as zeros without touching the device. */
+bool disk_fill_block_file(int thread_id, int fd, size_t length) {
+    struct stat st;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= length) return true;
+    if (fallocate(fd, 0, 0, (off_t)length) != 0 && errno != EOPNOTSUPP) return false;
+    
+    size_t chunk = 1024 * 1024;
+    char* buffer = NULL;
+    if (posix_memalign((void**)&buffer, DIRECT_IO_DEFAULT_ALIGNMENT, chunk) != 0) return false;
+    for (size_t i = 0; i < chunk; i++) buffer[i] = (char)((i + thread_id) % 256);
+    bool ok = true;
+    for (size_t offset = 0; offset < length && ok; offset += chunk) {
+        size_t n = (length - offset < chunk) ? length - offset : chunk;
+        ok = pwrite(fd, buffer, n, (off_t)offset) == (ssize_t)n;
+    }
+    free(buffer);
+    return ok && fdatasync(fd) == 0;
+}
+
+/* One thread's io_uring test, set up before the start gate so that opening
+ * and filling the file, allocating and registering the buffers and creating
+ * the ring all stay outside the measurement window */
+typedef struct {
+    int fd;
+    uring_workload_t workload;
+    bool write;
+    bool random;
+    bool sqpoll;                       // SQPOLL actually granted
+    bool fixed;                        // Buffers and file actually registered
+    size_t block;                      // Request size, rounded to the alignment
+    size_t num_blocks;
+    int queue_depth;
+    char* buffers;                     // queue_depth slots of `block` bytes
+    uint64_t* submitted;               // Submit time per slot, ns
+    int in_flight;                     // Requests the kernel may still own
+#ifdef HAVE_IO_URING
+    uring_t ring;
+#endif
+} uring_job_t;
+
+/* Prepare `workload` with `block`-byte requests over the first `length`
+ * bytes of the file at `queue_depth`; false (with nothing to release) when
+ * the file, buffers or ring cannot be set up */
+bool disk_uring_prepare(uring_job_t* job, int thread_id, const char* filename, size_t length,
+                        uring_workload_t workload, size_t block, int queue_depth) {
+    memset(job, 0, sizeof(*job));
+    job->fd = -1;
+#ifndef HAVE_IO_URING
+    (void)thread_id; (void)filename; (void)length; (void)workload; (void)block; (void)queue_depth;
+    return false;
+#else
+    job->workload = workload;
+    job->write = (workload == URING_SEQ_WRITE || workload == URING_RAND_WRITE);
+    job->random = (workload == URING_RAND_READ || workload == URING_RAND_WRITE);
+    job->queue_depth = queue_depth;
+    
+    bool direct;
+    int fd = disk_open_block_file(thread_id, filename, 0, &direct);
+    if (fd < 0 || !disk_fill_block_file(thread_id, fd, length)) {
+        log_message("Thread %d: cannot prepare %s for io_uring: %s", thread_id, filename, strerror(errno));
+        if (fd >= 0) close(fd);
+        return false;
+    }
+    size_t alignment = direct ? device_logical_block_size(fd) : DIRECT_IO_DEFAULT_ALIGNMENT;
+    block = (block + alignment - 1) / alignment * alignment;
+    job->block = block;
+    job->num_blocks = length / block;
+    if (job->num_blocks == 0) job->num_blocks = 1;
+    
+    job->submitted = calloc(queue_depth, sizeof(uint64_t));
+    if (!job->submitted || posix_memalign((void**)&job->buffers, alignment, (size_t)queue_depth * block) != 0) {
+        log_message("Thread %d: Memory allocation failed for io_uring QD%d", thread_id, queue_depth);
+        free(job->submitted);
+        close(fd);
+        return false;
+    }
+    memset(job->buffers, thread_id & 0xFF, (size_t)queue_depth * block);
+    
+    job->sqpoll = uring_sqpoll;
+    if (!uring_setup(&job->ring, (unsigned)queue_depth, job->sqpoll)) {
+        job->sqpoll = false;
+        if (!uring_sqpoll || !uring_setup(&job->ring, (unsigned)queue_depth, false)) {
+            log_message("Thread %d: io_uring_setup failed: %s", thread_id, strerror(errno));
+            free(job->submitted);
+            free(job->buffers);
+            close(fd);
+            return false;
+        }
+        verbose_log("Thread %d: SQPOLL refused, using regular submission", thread_id);
+    }
+    
+    // Registered buffers and files skip the per-request page pinning and fd lookup
+    job->fixed = uring_fixed;
+    if (job->fixed) {
+        struct iovec* iov = calloc(queue_depth, sizeof(struct iovec));
+        job->fixed = iov != NULL;
+        for (int q = 0; job->fixed && q < queue_depth; q++) {
+            iov[q].iov_base = job->buffers + (size_t)q * block;
+            iov[q].iov_len = block;
+        }
+        job->fixed = job->fixed &&
+                     syscall(__NR_io_uring_register, job->ring.fd, IORING_REGISTER_BUFFERS, iov, queue_depth) == 0 &&
+                     syscall(__NR_io_uring_register, job->ring.fd, IORING_REGISTER_FILES, &fd, 1) == 0;
+        free(iov);
+        if (!job->fixed) verbose_log("Thread %d: io_uring registration refused, using plain requests", thread_id);
+    }
+    job->fd = fd;
+    return true;
+#endif
+}
+
+/* Tear down a prepared job. Buffers the kernel may still be transferring
+ * into (requests that could not be drained) are deliberately leaked. */
+void disk_uring_release(uring_job_t* job, int thread_id) {
+#ifdef HAVE_IO_URING
+    if (job->fd < 0) return;
+    uring_close(&job->ring);
+    if (job->in_flight > 0) {
+        log_message("Thread %d: %d io_uring requests could not be drained; leaking their buffers",
+                    thread_id, job->in_flight);
+    } else {
+        free(job->buffers);
+    }
+    free(job->submitted);
+    close(job->fd);
+    job->fd = -1;
+#else
+    (void)job; (void)thread_id;
+#endif
+}
+
+#ifdef HAVE_IO_URING
+/* Reap every completion queued so far; returns how many were reaped */
+int uring_reap_all(uring_t* ring) {
+    int reaped = 0;
+    while (uring_peek_cqe(ring) != NULL) {
+        uring_cqe_seen(ring);
+        reaped++;
+    }
+    return reaped;
+}
+#endif
+
+/* Disk Benchmark Implementation 3: io_uring at a fixed queue depth on a
+ * prepared job. Every completion is immediately replaced by the next
+ * request of the workload, so queue_depth requests stay in flight until the
+ * deadline; requests still in flight then are drained and not counted. When
+ * `histogram` is given, each counted request's submit-to-completion time
+ * goes into it. */
+bool disk_benchmark_impl_uring(int thread_id, uring_job_t* job, double deadline,
+                               double *throughput, double *iops, latency_histogram_t* histogram) {
+    *throughput = *iops = 0;
+#ifndef HAVE_IO_URING
+    (void)thread_id; (void)job; (void)deadline; (void)histogram;
+    return false;
+#else
+    uring_t* ring = &job->ring;
+    size_t block = job->block;
+    uint64_t rng = 0x9E3779B97F4A7C15ULL ^ (uint64_t)thread_id;
+    size_t next_block = 0;
+    double completed_ops = 0;
+    bool ok = true;
+    
+    double start = monotonic_seconds();
+    for (int q = 0; q < job->queue_depth; q++) {
+        size_t index = job->random ? random_next(&rng) % job->num_blocks : next_block++ % job->num_blocks;
+        uring_queue_io(ring, job->fd, job->fixed, job->write, job->buffers + (size_t)q * block, block,
+                       (off_t)(index * block), q);
+        job->submitted[q] = monotonic_ns();
+    }
+    job->in_flight = job->queue_depth;
+    int to_submit = job->queue_depth;
+    double now = start;
+    
+    // Main measurement loop: reap, then refill every freed slot
+    while (job->in_flight > 0) {
+        if (uring_enter(ring, to_submit, 1) < 0) {
+            log_message("Thread %d: io_uring_enter failed: %s", thread_id, strerror(errno));
+            ok = false;
+            break;
+        }
+        to_submit = 0;
+        uint64_t now_ns = monotonic_ns();
+        now = now_ns / BILLION;
+        bool refill = ok && running && now < deadline;
+        
+        struct io_uring_cqe* cqe;
+        while ((cqe = uring_peek_cqe(ring)) != NULL) {
+            int slot = (int)cqe->user_data;
+            if (cqe->res != (int)block) {
+                if (ok) log_message("Thread %d: io_uring request failed: %s", thread_id,
+                                    cqe->res < 0 ? strerror(-cqe->res) : "short transfer");
+                ok = false;
+                refill = false;
+            } else if (now <= deadline) {
+                completed_ops++;
+                if (histogram) histogram_record(histogram, now_ns - job->submitted[slot]);
+            }
+            uring_cqe_seen(ring);
+            job->in_flight--;
+            
+            if (refill) {
+                size_t index = job->random ? random_next(&rng) % job->num_blocks
+                                           : next_block++ % job->num_blocks;
+                uring_queue_io(ring, job->fd, job->fixed, job->write, job->buffers + (size_t)slot * block, block,
+                               (off_t)(index * block), slot);
+                job->submitted[slot] = now_ns;
+                job->in_flight++;
+                to_submit++;
+            }
+        }
+    }
+    double elapsed = ((now < deadline) ? now : deadline) - start;
+    
+    // After a failed enter the kernel may still own requests: drain what it
+    // completes, giving up (and leaking the buffers) if waiting fails too
+    for (int attempts = 0; job->in_flight > 0 && attempts < 1000; ) {
+        if (uring_enter(ring, to_submit, 1) < 0) {
+            attempts++;
+            usleep(1000);
+        } else {
+            to_submit = 0;
+        }
+        job->in_flight -= uring_reap_all(ring);
+    }
+    if (!ok) return false;
+    
+    *iops = (elapsed > 0) ? completed_ops / elapsed : 0;
+    *throughput = *iops * block / (1024 * 1024);
+    verbose_log("Thread %d: io_uring %s QD%d%s%s: %.2f MB/s, %.0f IOPS", thread_id,
+                uring_workload_names[job->workload], job->queue_depth, job->sqpoll ? " SQPOLL" : "",
+                job->fixed ? " fixed" : "", *throughput, *iops);
+    return true;
+#endif
+}
+
+/* Random I/O profiles over one large file per thread: reads, writes, or
+ * a mix where each request is a read with probability random_read_percent */
+typedef enum {
+    RANDOM_PROFILE_READ,
+    RANDOM_PROFILE_WRITE,
+    RANDOM_PROFILE_MIXED,
+    RANDOM_NUM_PROFILES
+} random_profile_t;
+
+const char* const random_profile_names[RANDOM_NUM_PROFILES] = {"read", "write", "mixed"};
+
+/* Durability of random writes */
+typedef enum {
+    SYNC_NONE,                         // No explicit sync
+    SYNC_FDATASYNC,                    // fdatasync() after every random_sync_every writes
+    SYNC_DSYNC                         // File opened O_DSYNC: every write is durable
+} sync_mode_t;
+
+bool run_random_profile[RANDOM_NUM_PROFILES];
+random_profile_t random_profile = RANDOM_PROFILE_READ;  // Profile currently being measured
+thread_stats_t random_read_stats[RANDOM_NUM_PROFILES];  // Reads per second
+thread_stats_t random_write_stats[RANDOM_NUM_PROFILES]; // Writes per second
+latency_histogram_t random_read_latency[RANDOM_NUM_PROFILES];   // ns per pread()
+latency_histogram_t random_write_latency[RANDOM_NUM_PROFILES];  // ns per pwrite()
+latency_histogram_t random_sync_latency[RANDOM_NUM_PROFILES];   // ns per fdatasync()
+
+/* The file per thread. O_DIRECT requests bypass the page cache, so a
+ * modest file is enough; a buffered file must exceed the thread's share of
+ * RAM for most reads to miss the cache. With the page cache holding at
+ * most one RAM share, 4x keeps the cache hit rate at or below a quarter. */
+#define RANDOM_DIRECT_FILE_SIZE (1024UL * 1024 * 1024)     // 1 GiB
+#define RANDOM_RAM_MULTIPLE 4
+
+bool random_size_warned = false;       // Small-file warning already logged
+
+/* Per-thread random I/O file size: --rand-file when given, otherwise as
+ * above but never more than half the free space shared by all threads.
+ * A buffered file below the thread's RAM share is mostly served from the
+ * page cache, which is logged once. */
+size_t random_plan_file_size(bool direct) {
+    size_t ram_share = (size_t)sysconf(_SC_PHYS_PAGES) * (size_t)sysconf(_SC_PAGESIZE) / num_threads;
+    size_t size = random_file_size;
+    if (size == 0) {
+        size = direct ? RANDOM_DIRECT_FILE_SIZE : RANDOM_RAM_MULTIPLE * ram_share;
+        struct statvfs fs;
+        if (statvfs(".", &fs) == 0) {
+            size_t cap = (size_t)fs.f_bavail * fs.f_frsize / 2 / num_threads;
+            if (size > cap) size = cap;
+        }
+    }
+    size -= size % (1024 * 1024);
+    if (size < 1024 * 1024) size = 1024 * 1024;
+    
+    if (!direct && size < ram_share && !__atomic_exchange_n(&random_size_warned, true, __ATOMIC_RELAXED)) {
+        log_message("Buffered random I/O file of %zu MB per thread is below the thread's "
+                    "%zu MB share of RAM; most requests will hit the page cache", size / (1024 * 1024),
+                    ram_share / (1024 * 1024));
+    }
+    return size;
+}
+
+/* Name of a thread's random I/O file */
+void random_file_name(char* name, size_t len, const thread_args_t* t_args) {
+    snprintf(name, len, "%s.rand", t_args->temp_filename);
+}
+
+/* Disk Benchmark Implementation 4: random I/O IOPS. Block-aligned
+ * pread()/pwrite()s of `request` bytes at uniformly random offsets of an
+ * open, filled file; opening and filling happen outside the timed region.
+ * Syncs required by random_sync_mode are inside it. Every request and sync
+ * is also timed into the caller's histograms (read, write, sync). */
+bool disk_benchmark_impl_random(int thread_id, double deadline, int fd, size_t length, size_t alignment,
+                                size_t request, int read_percent, double *read_iops, double *write_iops,
+                                latency_histogram_t* histograms) {
+    *read_iops = *write_iops = 0;
+    size_t block = (request + alignment - 1) / alignment * alignment;
+    size_t num_blocks = length / block;
+    char* buffer = NULL;
+    if (num_blocks == 0 || posix_memalign((void**)&buffer, alignment, block) != 0) return false;
+    memset(buffer, thread_id & 0xFF, block);
+    
+    double start, end;
+    double total_reads = 0, total_writes = 0, total_time = 0;
+    long long batch = 64;
+    long long unsynced = 0;
+    uint64_t rng = 0xD1B54A32D192ED03ULL ^ (uint64_t)thread_id;
+    bool ok = true;
+    
+    // Main measurement loop
+    while (ok && running && monotonic_seconds() < deadline) {
+        long long reads = 0, writes = 0;
+        start = monotonic_seconds();
+        for (long long i = 0; i < batch && ok; i++) {
+            off_t offset = (off_t)((random_next(&rng) % num_blocks) * block);
+            uint64_t op_start = monotonic_ns();
+            if ((int)(random_next(&rng) % 100) < read_percent) {
+                ok = pread(fd, buffer, block, offset) == (ssize_t)block;
+                histogram_record(&histograms[0], elapsed_ns(op_start));
+                reads++;
+            } else {
+                ok = pwrite(fd, buffer, block, offset) == (ssize_t)block;
+                histogram_record(&histograms[1], elapsed_ns(op_start));
+                writes++;
+                if (ok && random_sync_mode == SYNC_FDATASYNC && ++unsynced >= random_sync_every) {
+                    op_start = monotonic_ns();
+                    ok = fdatasync(fd) == 0;
+                    histogram_record(&histograms[2], elapsed_ns(op_start));
+                    unsynced = 0;
+                }
+            }
+        }
+        end = monotonic_seconds();
+        if (!ok) break;
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_reads += reads * in_window;
+        total_writes += writes * in_window;
+        total_time += (end - start) * in_window;
+        batch = calibrate_batch(batch, end - start);
+        
+        load_profile_pause();
+    }
+    
+    if (!ok) log_message("Thread %d: random I/O failed: %s", thread_id, strerror(errno));
+    free(buffer);
+    if (!ok || total_time <= 0) return false;
+    
+    *read_iops = total_reads / total_time;
+    *write_iops = total_writes / total_time;
+    return true;
+}
+
+/* Commit latency: append records to a log file and make them durable with
+ * fdatasync(), the way a write-ahead log commits. Every record is synced on
+ * its own, or commit_group_size records share one sync (group commit). */
+#define COMMIT_NUM_SIZES 4
+#define COMMIT_NUM_VARIANTS 2                   // Sync per record, group commit
+#define COMMIT_SEGMENT_SIZE (64UL * 1024 * 1024) // The log restarts at offset 0 past this
+
+const size_t commit_record_sizes[COMMIT_NUM_SIZES] = {512, 4096, 16384, 65536};
+size_t commit_record_size = 512;                // Record size currently being measured
+int commit_group = 1;                           // Records per sync currently being measured
+thread_stats_t commit_stats[COMMIT_NUM_SIZES][COMMIT_NUM_VARIANTS];        // Commits (syncs) per second
+latency_histogram_t commit_latency[COMMIT_NUM_SIZES][COMMIT_NUM_VARIANTS];  // ns from first write to sync
+latency_histogram_t* commit_histogram = NULL;   // Histogram of the cell being measured
+
+/* Disk Benchmark Implementation 5: commits per second. A commit is `group`
+ * appended records of `record` bytes followed by fdatasync(); its latency
+ * from the first write to the sync returning goes into `histogram`. */
+double disk_benchmark_impl_commit(int thread_id, double deadline, int fd, size_t record, int group,
+                                  latency_histogram_t* histogram) {
+    char* buffer = malloc(record);
+    if (!buffer) return 0;
+    memset(buffer, 'L' ^ (thread_id & 0xFF), record);
+    
+    double start, end;
+    double total_commits = 0, total_time = 0;
+    long long batch = 16;
+    off_t offset = 0;
+    bool ok = true;
+    long long segment_commits = (long long)(COMMIT_SEGMENT_SIZE / (record * group));
+    if (segment_commits < 1) segment_commits = 1;
+    
+    // Main measurement loop
+    while (ok && running && monotonic_seconds() < deadline) {
+        // Recycle the segment between batches, outside the timed bracket
+        if (batch > segment_commits) batch = segment_commits;
+        if (offset + (off_t)(batch * record * group) > (off_t)COMMIT_SEGMENT_SIZE) {
+            ok = ftruncate(fd, 0) == 0;
+            offset = 0;
+            if (!ok) break;
+        }
+        
+        start = monotonic_seconds();
+        for (long long i = 0; i < batch && ok; i++) {
+            uint64_t commit_start = monotonic_ns();
+            for (int r = 0; r < group && ok; r++) {
+                ok = pwrite(fd, buffer, record, offset) == (ssize_t)record;
+                offset += record;
+            }
+            if (ok) ok = fdatasync(fd) == 0;
+            if (ok) histogram_record(histogram, elapsed_ns(commit_start));
+        }
+        end = monotonic_seconds();
+        if (!ok) break;
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_commits += batch * in_window;
+        total_time += (end - start) * in_window;
+        batch = calibrate_batch(batch, end - start);
+        
+        load_profile_pause();
+    }
+    
+    if (!ok) log_message("Thread %d: commit test failed: %s", thread_id, strerror(errno));
+    free(buffer);
+    return (ok && total_time > 0) ? total_commits / total_time : 0;
+}
+
+/* Memory-mapped file I/O, compared with the system-call path on the same
+ * file: read() for the sequential scan, pread() for random reads and
+ * pwrite() + fdatasync() for sequential writes, which map to a MAP_SHARED
+ * mapping synced with msync(). Every cell starts with a cold page cache. */
+typedef enum {
+    MMAP_SEQ_READ,
+    MMAP_RAND_READ,
+    MMAP_SEQ_WRITE,
+    MMAP_NUM_WORKLOADS
+} mmap_workload_t;
+
+typedef enum {
+    MMAP_PATH_SYSCALL,                 // read()/pread()/pwrite()
+    MMAP_PATH_MMAP,                    // Mapping faulted in on access
+    MMAP_PATH_POPULATE,                // MAP_POPULATE: faulted in before the window
+    MMAP_NUM_PATHS
+} mmap_path_t;
+
+const char* const mmap_workload_names[MMAP_NUM_WORKLOADS] = {"seq-read", "rand-read", "seq-write"};
+const char* const mmap_path_names[MMAP_NUM_PATHS] = {"syscall", "mmap", "mmap+populate"};
+mmap_workload_t mmap_workload = MMAP_SEQ_READ;  // Cell currently being measured
+mmap_path_t mmap_path = MMAP_PATH_SYSCALL;
+thread_stats_t mmap_throughput_stats[MMAP_NUM_WORKLOADS][MMAP_NUM_PATHS];
+thread_stats_t mmap_minor_fault_stats[MMAP_NUM_WORKLOADS][MMAP_NUM_PATHS];
+thread_stats_t mmap_major_fault_stats[MMAP_NUM_WORKLOADS][MMAP_NUM_PATHS];
+
+/* Sum of the 64-bit words of a block, so that mapped and copied data are
+ * both actually consumed */
+uint64_t mmap_checksum(const char* data, size_t length) {
+    const uint64_t* words = (const uint64_t*)data;
+    uint64_t sum = 0;
+    for (size_t i = 0; i < length / sizeof(uint64_t); i++) sum += words[i];
+    return sum;
+}
+
+/* Request size of an mmap workload over a `length`-byte file */
+size_t mmap_block_size(mmap_workload_t workload, size_t length) {
+    size_t block = (workload == MMAP_RAND_READ) ? random_block_size : io_block_size;
+    return (block > length) ? length : block;
+}
+
+/* Disk Benchmark Implementation 6: file I/O through `map` (a MAP_SHARED
+ * mapping of the whole file) or, when map is NULL, through system calls on
+ * fd. Sequential workloads move io_block_size per request and wrap at the
+ * end of the file; a wrapping write pass is made durable first. Random reads
+ * move random_block_size. `buffer` holds mmap_block_size() bytes and is
+ * allocated and touched by the caller, so its page faults are not counted
+ * against the mapping. Returns MB/s. */
+double disk_benchmark_impl_mmap(int thread_id, double deadline, int fd, char* map, char* buffer,
+                                size_t length, mmap_workload_t workload) {
+    size_t block = mmap_block_size(workload, length);
+    size_t num_blocks = (block > 0) ? length / block : 0;
+    if (num_blocks == 0) return 0;
+    
+    double start, end;
+    double total_bytes = 0, total_time = 0;
+    long long batch = 16;
+    size_t next_block = 0;
+    uint64_t rng = 0x9FB21C651E98DF25ULL ^ (uint64_t)thread_id;
+    uint64_t checksum = 0;
+    bool ok = lseek(fd, 0, SEEK_SET) == 0;
+    
+    // Main measurement loop
+    while (ok && running && monotonic_seconds() < deadline) {
+        start = monotonic_seconds();
+        for (long long i = 0; i < batch && ok; i++) {
+            if (next_block == num_blocks) {
+                // End of a sequential pass
+                if (workload == MMAP_SEQ_WRITE) {
+                    ok = (map ? msync(map, length, MS_SYNC) : fdatasync(fd)) == 0;
+                } else if (!map) {
+                    ok = lseek(fd, 0, SEEK_SET) == 0;
+                }
+                next_block = 0;
+            }
+            size_t b = (workload == MMAP_RAND_READ) ? random_next(&rng) % num_blocks : next_block++;
+            char* addr = map ? map + b * block : buffer;
+            switch (workload) {
+                case MMAP_SEQ_READ:
+                    if (!map) ok = read(fd, buffer, block) == (ssize_t)block;
+                    checksum += mmap_checksum(addr, block);
+                    break;
+                case MMAP_RAND_READ:
+                    if (!map) ok = pread(fd, buffer, block, (off_t)(b * block)) == (ssize_t)block;
+                    checksum += mmap_checksum(addr, block);
+                    break;
+                default:
+                    if (map) {
+                        memcpy(addr, buffer, block);
+                    } else {
+                        ok = pwrite(fd, buffer, block, (off_t)(b * block)) == (ssize_t)block;
+                    }
+                    break;
+            }
+        }
+        end = monotonic_seconds();
+        if (!ok) break;
+        
+        double in_window = window_fraction(start, end, deadline);
+        total_bytes += (double)batch * block * in_window;
+        total_time += (end - start) * in_window;
+        batch = calibrate_batch(batch, end - start);
+        
+        load_profile_pause();
+    }
+    
+    if (!ok) log_message("Thread %d: mmap test failed: %s", thread_id, strerror(errno));
+    // Make the checksum observable so the reads cannot be elided
+    if (checksum == 1) verbose_log("Thread %d: mmap checksum %llu", thread_id, (unsigned long long)checksum);
+    return (ok && total_time > 0) ? total_bytes / total_time / (1024 * 1024) : 0;
+}
+
+/* Queue depth x block size sweep of random reads for each I/O engine, to
+ * find where a device saturates. The synchronous engine has one request in
+ * flight per thread by construction, so it only runs at queue depth 1. */
+typedef enum {
+    IO_ENGINE_PSYNC,                   // pread(), O_DIRECT where supported
+    IO_ENGINE_URING,                   // io_uring, same file and flags
+    IO_NUM_ENGINES
+} io_engine_t;
+
+#define IO_SWEEP_NUM_BLOCKS 5
+#define IO_SWEEP_NUM_DEPTHS 9
+
+/* One cell of the sweep, summed over threads */
+typedef struct {
+    bool measured;
+    thread_stats_t iops;
+    double throughput;                 // MB/s
+    double mean_us;                    // Request latency
+    double p50_us;
+    double p99_us;
+    double max_us;
+} io_sweep_cell_t;
+
+const char* const io_engine_names[IO_NUM_ENGINES] = {"psync", "io_uring"};
+const size_t io_sweep_blocks[IO_SWEEP_NUM_BLOCKS] = {4096, 16384, 65536, 262144, 1048576};
+const int io_sweep_depths[IO_SWEEP_NUM_DEPTHS] = {1, 2, 4, 8, 16, 32, 64, 128, 256};
+io_engine_t io_sweep_engine = IO_ENGINE_PSYNC;  // Cell currently being measured
+size_t io_sweep_block = 4096;
+int io_sweep_depth = 1;
+io_sweep_cell_t io_sweep_cells[IO_NUM_ENGINES][IO_SWEEP_NUM_BLOCKS][IO_SWEEP_NUM_DEPTHS];
+latency_histogram_t io_sweep_histogram;         // Latency of the cell being measured
+
+/* CPU benchmark thread function */
+void* cpu_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("CPU benchmark thread %d started", t_args->thread_id);
+    
+    // Run the FLOPS benchmark
+    double flops = cpu_benchmark_impl_flops(t_args->thread_id, deadline);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.cpu_flops = flops;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("CPU benchmark thread %d completed. Result: %.2f MFLOPS", 
+                t_args->thread_id, flops / 1000000.0);
+    return NULL;
+}
+
+/* Peak FLOPS benchmark thread function */
+void* cpu_peak_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("Peak FLOPS benchmark thread %d started", t_args->thread_id);
+    
+    double flops = cpu_benchmark_impl_peak_flops(t_args->thread_id, deadline);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.cpu_peak_flops = flops;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("Peak FLOPS benchmark thread %d completed. Result: %.2f GFLOPS",
+                t_args->thread_id, flops / BILLION);
+    return NULL;
+}
+
+/* Vectorized transcendental benchmark thread function */
+void* cpu_vector_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("Vector math benchmark thread %d started", t_args->thread_id);
+    
+    double flops = cpu_benchmark_impl_vector_flops(t_args->thread_id, deadline);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.cpu_vector_flops = flops;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("Vector math benchmark thread %d completed. Result: %.2f MFLOPS",
+                t_args->thread_id, flops / 1000000.0);
+    return NULL;
+}
+
+/* DGEMM benchmark thread function; CPU threads split the rows of C */
+void* cpu_dgemm_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double flops = cpu_benchmark_impl_dgemm(t_args->thread_id, t_args->thread_id, num_threads, deadline);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.cpu_dgemm_flops = flops;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    verbose_log("DGEMM benchmark thread %d completed. Result: %.2f GFLOPS",
+                t_args->thread_id, flops / BILLION);
+    return NULL;
+}
+
+/* Memory benchmark thread function */
+void* memory_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    if (run_numa) numa_place_memory_thread(t_args->thread_id - num_threads);
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("Memory benchmark thread %d started", t_args->thread_id);
+    
+    double read_bandwidth = 0.0, write_bandwidth = 0.0, nt_write_bandwidth = 0.0, touch_bandwidth = 0.0;
+    
+    // Run the memory bandwidth benchmark
+    memory_benchmark_impl_bandwidth(t_args->thread_id, deadline, &read_bandwidth,
+                                  &write_bandwidth, &nt_write_bandwidth, &touch_bandwidth);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.memory_read_bandwidth = read_bandwidth;
+    t_args->thread_results.memory_write_bandwidth = write_bandwidth;
+    t_args->thread_results.memory_nt_write_bandwidth = nt_write_bandwidth;
+    t_args->thread_results.memory_touch_bandwidth = touch_bandwidth;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("Memory benchmark thread %d completed. Read: %.2f MB/s, Write: %.2f MB/s",
+                t_args->thread_id, read_bandwidth, write_bandwidth);
+    
+    return NULL;
+}
+
+/* STREAM benchmark thread function: allocates and initializes its arrays
+ * before the gate */
+void* memory_stream_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    stream_arrays_t arrays;
+    bool ok = stream_arrays_alloc(&arrays, t_args->thread_id);
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("STREAM benchmark thread %d started", t_args->thread_id);
+    
+    double bandwidth[STREAM_NUM_KERNELS] = {0};
+    bool verified = true;
+    if (ok) {
+        verified = memory_benchmark_impl_stream(t_args->thread_id, &arrays, deadline, bandwidth);
+        stream_arrays_free(&arrays);
+    }
+    
+    pthread_mutex_lock(&results_mutex);
+    if (!verified) stream_verified = false;
+    t_args->thread_results.stream_copy_bandwidth = bandwidth[STREAM_COPY];
+    t_args->thread_results.stream_scale_bandwidth = bandwidth[STREAM_SCALE];
+    t_args->thread_results.stream_add_bandwidth = bandwidth[STREAM_ADD];
+    t_args->thread_results.stream_triad_bandwidth = bandwidth[STREAM_TRIAD];
+    t_args->completed = ok;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("STREAM benchmark thread %d completed. Triad: %.2f MB/s",
+                t_args->thread_id, bandwidth[STREAM_TRIAD]);
+    
+    return NULL;
+}
+
+/* Memory latency thread function: builds its chain before the gate so
+ * setup never eats into the measurement window */
+void* memory_latency_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    latency_node_t* head = NULL;
+    latency_node_t* nodes = memory_latency_prepare(t_args->thread_id, latency_working_set, &head);
+    double deadline = start_gate_wait(&phase_gate);
+    
+    latency_histogram_t* histogram = calloc(1, sizeof(latency_histogram_t));
+    bool prepared = (nodes != NULL);   // nodes is freed before the results are stored
+    double latency = prepared ? memory_benchmark_impl_latency(t_args->thread_id, head, deadline, histogram) : 0;
+    free(nodes);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.memory_latency_ns = latency;
+    t_args->completed = prepared;
+    if (prepared && histogram && latency_histogram) histogram_merge(latency_histogram, histogram);
+    pthread_mutex_unlock(&results_mutex);
+    free(histogram);
+    
+    verbose_log("Memory latency thread %d: %zu KB working set, %.2f ns per load",
+                t_args->thread_id, latency_working_set / 1024, latency);
+    return NULL;
+}
+
+/* Cache sweep thread function: each memory thread sweeps its own buffer */
+void* memory_sweep_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    char* buffer = NULL;
+    if (posix_memalign((void**)&buffer, 64, cache_sweep_size) != 0) {
+        log_message("Thread %d: Memory allocation failed for %zu KB sweep buffer",
+                    t_args->thread_id, cache_sweep_size / 1024);
+        buffer = NULL;
+    } else {
+        memset(buffer, 1, cache_sweep_size);
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double read_bandwidth = 0.0, write_bandwidth = 0.0;
+    bool prepared = (buffer != NULL);  // buffer is freed before the results are stored
+    if (prepared) {
+        memory_benchmark_impl_sweep(t_args->thread_id, buffer, cache_sweep_size, deadline,
+                                    &read_bandwidth, &write_bandwidth);
+    }
+    free(buffer);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.sweep_read_bandwidth = read_bandwidth;
+    t_args->thread_results.sweep_write_bandwidth = write_bandwidth;
+    t_args->completed = prepared;
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* NUMA matrix bandwidth thread: runs on a CPU of numa_cpu_node with its
+ * buffer bound to numa_mem_node, placed and touched before the gate; not
+ * completed when the kernel refuses the binding */
+void* memory_numa_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    numa_pin_thread(&numa_nodes[numa_cpu_node], t_args->thread_id - num_threads);
+    bool bound = false;
+    char* buffer = numa_alloc_on_node(memory_block_size, &numa_nodes[numa_mem_node], &bound);
+    if (!buffer) {
+        log_message("Thread %d: Memory allocation failed for NUMA test", t_args->thread_id);
+    } else {
+        memset(buffer, 1, memory_block_size);
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double read_bandwidth = 0.0, write_bandwidth = 0.0;
+    if (buffer) {
+        memory_benchmark_impl_sweep(t_args->thread_id, buffer, memory_block_size, deadline,
+                                    &read_bandwidth, &write_bandwidth);
+        munmap(buffer, memory_block_size);
+    }
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.numa_read_bandwidth = read_bandwidth;
+    t_args->thread_results.numa_write_bandwidth = write_bandwidth;
+    t_args->completed = buffer && bound;
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* NUMA matrix latency thread: pointer chase over LATENCY_LLC_MULTIPLE x LLC
+ * bound to numa_mem_node, from a CPU of numa_cpu_node; not completed when
+ * the kernel refuses the binding */
+void* memory_numa_latency_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    size_t working_set = detect_llc_size() * LATENCY_LLC_MULTIPLE;
+    size_t count = working_set / sizeof(latency_node_t);
+    numa_pin_thread(&numa_nodes[numa_cpu_node], 0);
+    bool bound = false;
+    latency_node_t* nodes = numa_alloc_on_node(count * sizeof(latency_node_t),
+                                               &numa_nodes[numa_mem_node], &bound);
+    latency_node_t* head = nodes ? latency_build_chain(nodes, count, 0x5DEECE66DULL + t_args->thread_id) : NULL;
+    if (head) {
+        head = latency_chase(head, (long long)count);
+    } else {
+        log_message("Thread %d: Memory allocation failed for NUMA latency test", t_args->thread_id);
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double latency = head ? memory_benchmark_impl_latency(t_args->thread_id, head, deadline, NULL) : 0;
+    if (nodes) munmap(nodes, count * sizeof(latency_node_t));
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.numa_latency_ns = latency;
+    t_args->completed = head && bound;
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* Page size comparison bandwidth thread: a memory_block_size buffer with
+ * exactly page_test_backing; not completed when the backing is unavailable */
+void* memory_pages_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    memory_buffer_t mapping = {0};
+    bool ok = memory_buffer_alloc(&mapping, memory_block_size, page_test_backing);
+    if (ok) memset(mapping.ptr, 1, memory_block_size);
+    double huge_fraction = ok ? memory_buffer_huge_fraction(&mapping) : 0;
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double read_bandwidth = 0.0, write_bandwidth = 0.0;
+    if (ok) {
+        memory_benchmark_impl_sweep(t_args->thread_id, mapping.ptr, memory_block_size, deadline,
+                                    &read_bandwidth, &write_bandwidth);
+        memory_buffer_free(&mapping);
+    }
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.pages_read_bandwidth = read_bandwidth;
+    t_args->thread_results.pages_write_bandwidth = write_bandwidth;
+    t_args->thread_results.pages_huge_fraction = huge_fraction;
+    t_args->completed = ok;
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* Page size comparison latency thread: pointer chase over
+ * LATENCY_LLC_MULTIPLE x LLC, where TLB reach matters most */
+void* memory_pages_latency_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    size_t count = detect_llc_size() * LATENCY_LLC_MULTIPLE / sizeof(latency_node_t);
+    memory_buffer_t mapping = {0};
+    latency_node_t* head = NULL;
+    if (memory_buffer_alloc(&mapping, count * sizeof(latency_node_t), page_test_backing)) {
+        head = latency_build_chain((latency_node_t*)mapping.ptr, count, 0x5DEECE66DULL + t_args->thread_id);
+        if (head) head = latency_chase(head, (long long)count);
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double latency = head ? memory_benchmark_impl_latency(t_args->thread_id, head, deadline, NULL) : 0;
+    memory_buffer_free(&mapping);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.pages_latency_ns = latency;
+    t_args->completed = (head != NULL);
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* I/O benchmark thread function */
+void* io_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    log_message("I/O benchmark thread %d started", t_args->thread_id);
+    
+    double read_throughput = 0.0, write_throughput = 0.0, seek_iops = 0.0;
+    
+    // Run the disk throughput benchmark
+    disk_benchmark_impl_throughput(t_args->thread_id, deadline, t_args->temp_filename,
+                                &read_throughput, &write_throughput, &seek_iops);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.disk_read_throughput = read_throughput;
+    t_args->thread_results.disk_write_throughput = write_throughput;
+    t_args->thread_results.disk_seek_iops = seek_iops;
+    t_args->completed = true;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("I/O benchmark thread %d completed. Read: %.2f MB/s, Write: %.2f MB/s, IOPS: %.2f",
+                t_args->thread_id, read_throughput, write_throughput, seek_iops);
+    
+    return NULL;
+}
+
+/* O_DIRECT benchmark thread function */
+void* io_direct_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double read_throughput = 0.0, write_throughput = 0.0;
+    bool ok = disk_benchmark_impl_direct(t_args->thread_id, deadline, t_args->temp_filename,
+                                         &read_throughput, &write_throughput);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.direct_read_throughput = read_throughput;
+    t_args->thread_results.direct_write_throughput = write_throughput;
+    t_args->completed = ok;
+    pthread_mutex_unlock(&results_mutex);
+    
+    log_message("O_DIRECT benchmark thread %d completed. Read: %.2f MB/s, Write: %.2f MB/s",
+                t_args->thread_id, read_throughput, write_throughput);
+    return NULL;
+}
+
+/* Random I/O thread function: its own large file, prepared before the
+ * gate and kept for the following profiles (main removes it) */
+void* io_random_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    char filename[96];
+    random_file_name(filename, sizeof(filename), t_args);
+    
+    bool direct;
+    size_t length = 0;
+    int fd = disk_open_block_file(t_args->thread_id, filename, random_sync_mode == SYNC_DSYNC ? O_DSYNC : 0,
+                                  &direct);
+    if (fd >= 0) {
+        length = random_plan_file_size(direct);
+        verbose_log("Thread %d: random I/O file %zu MB (%s)", t_args->thread_id,
+                    length / (1024 * 1024), direct ? "O_DIRECT" : "buffered");
+        if (!disk_fill_block_file(t_args->thread_id, fd, length)) {
+            log_message("Thread %d: cannot preallocate %zu MB for random I/O: %s",
+                        t_args->thread_id, length / (1024 * 1024), strerror(errno));
+            close(fd);
+            fd = -1;
+        }
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    int read_percent = (random_profile == RANDOM_PROFILE_READ) ? 100
+                     : (random_profile == RANDOM_PROFILE_WRITE) ? 0 : random_read_percent;
+    double read_iops = 0.0, write_iops = 0.0;
+    bool ok = false;
+    latency_histogram_t* histograms = calloc(3, sizeof(latency_histogram_t));
+    if (fd >= 0 && histograms) {
+        size_t alignment = direct ? device_logical_block_size(fd) : DIRECT_IO_DEFAULT_ALIGNMENT;
+        ok = disk_benchmark_impl_random(t_args->thread_id, deadline, fd, length, alignment, random_block_size,
+                                        read_percent, &read_iops, &write_iops, histograms);
+    }
+    if (fd >= 0) close(fd);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.random_read_iops = read_iops;
+    t_args->thread_results.random_write_iops = write_iops;
+    t_args->completed = ok;
+    if (ok) {
+        histogram_merge(&random_read_latency[random_profile], &histograms[0]);
+        histogram_merge(&random_write_latency[random_profile], &histograms[1]);
+        histogram_merge(&random_sync_latency[random_profile], &histograms[2]);
+    }
+    pthread_mutex_unlock(&results_mutex);
+    free(histograms);
+    
+    log_message("Random %s thread %d completed. %.0f reads/s, %.0f writes/s",
+                random_profile_names[random_profile], t_args->thread_id, read_iops, write_iops);
+    return NULL;
+}
+
+/* Commit latency thread function: appends to its own log file, buffered
+ * like a typical write-ahead log, which is removed afterwards */
+void* io_commit_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    char filename[96];
+    snprintf(filename, sizeof(filename), "%s.wal", t_args->temp_filename);
+    int fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        log_message("Thread %d: cannot create %s: %s", t_args->thread_id, filename, strerror(errno));
+    }
+    latency_histogram_t* histogram = calloc(1, sizeof(latency_histogram_t));
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double commits = 0.0;
+    if (fd >= 0 && histogram) {
+        commits = disk_benchmark_impl_commit(t_args->thread_id, deadline, fd, commit_record_size,
+                                             commit_group, histogram);
+    }
+    if (fd >= 0) {
+        close(fd);
+        remove(filename);
+    }
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.commit_rate = commits;
+    t_args->completed = commits > 0;
+    if (commits > 0 && commit_histogram) histogram_merge(commit_histogram, histogram);
+    pthread_mutex_unlock(&results_mutex);
+    free(histogram);
+    
+    verbose_log("Commit thread %d: %zu B x%d, %.2f commits/s", t_args->thread_id, commit_record_size,
+                commit_group, commits);
+    return NULL;
+}
+
+/* Name of a thread's memory-mapped I/O file */
+void mmap_file_name(char* name, size_t len, const thread_args_t* t_args) {
+    snprintf(name, len, "%s.mmap", t_args->temp_filename);
+}
+
+/* Memory-mapped I/O thread function: one workload through one path. The
+ * file is kept for the following cells (main removes it); its cached pages
+ * are dropped before each cell, and page faults are counted for the
+ * measurement window only. */
+void* io_mmap_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    char filename[96];
+    mmap_file_name(filename, sizeof(filename), t_args);
+    bool sequential = (mmap_workload != MMAP_RAND_READ);
+    
+    char* map = NULL;
+    size_t block = mmap_block_size(mmap_workload, file_size);
+    char* buffer = malloc(block ? block : 1);
+    int fd = open(filename, O_RDWR | O_CREAT, 0644);
+    bool ok = buffer && fd >= 0 && disk_fill_block_file(t_args->thread_id, fd, file_size) && fdatasync(fd) == 0;
+    if (buffer) memset(buffer, 'M' ^ (t_args->thread_id & 0xFF), block);
+    if (ok) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        if (mmap_path == MMAP_PATH_SYSCALL) {
+            posix_fadvise(fd, 0, 0, sequential ? POSIX_FADV_SEQUENTIAL : POSIX_FADV_RANDOM);
+        } else {
+            int flags = MAP_SHARED | (mmap_path == MMAP_PATH_POPULATE ? MAP_POPULATE : 0);
+            map = mmap(NULL, file_size, PROT_READ | PROT_WRITE, flags, fd, 0);
+            if (map == MAP_FAILED) {
+                map = NULL;
+                ok = false;
+            } else {
+                madvise(map, file_size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+            }
+        }
+    }
+    if (!ok) {
+        log_message("Thread %d: cannot prepare %s for the mmap test: %s", t_args->thread_id, filename,
+                    strerror(errno));
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double throughput = 0.0;
+    struct rusage before, after;
+    getrusage(RUSAGE_THREAD, &before);
+    if (ok) {
+        throughput = disk_benchmark_impl_mmap(t_args->thread_id, deadline, fd, map, buffer, file_size,
+                                              mmap_workload);
+    }
+    getrusage(RUSAGE_THREAD, &after);
+    free(buffer);
+    if (map) munmap(map, file_size);
+    if (fd >= 0) close(fd);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.mmap_throughput = throughput;
+    t_args->thread_results.mmap_minor_faults = (double)(after.ru_minflt - before.ru_minflt);
+    t_args->thread_results.mmap_major_faults = (double)(after.ru_majflt - before.ru_majflt);
+    t_args->completed = throughput > 0;
+    pthread_mutex_unlock(&results_mutex);
+    
+    verbose_log("mmap thread %d: %s via %s, %.2f MB/s, %ld minor / %ld major faults", t_args->thread_id,
+                mmap_workload_names[mmap_workload], mmap_path_names[mmap_path], throughput,
+                after.ru_minflt - before.ru_minflt, after.ru_majflt - before.ru_majflt);
+    return NULL;
+}
+
+/* io_uring benchmark thread function: one workload at one queue depth */
+void* io_uring_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    bool random = (uring_workload == URING_RAND_READ || uring_workload == URING_RAND_WRITE);
+    uring_job_t job;
+    bool ok = disk_uring_prepare(&job, t_args->thread_id, t_args->temp_filename, file_size, uring_workload,
+                                 random ? random_block_size : io_block_size, uring_queue_depth);
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double throughput = 0.0, iops = 0.0;
+    if (ok) {
+        ok = disk_benchmark_impl_uring(t_args->thread_id, &job, deadline, &throughput, &iops, NULL);
+        disk_uring_release(&job, t_args->thread_id);
+    }
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.uring_throughput = throughput;
+    t_args->thread_results.uring_iops = iops;
+    t_args->completed = ok;
+    pthread_mutex_unlock(&results_mutex);
+    
+    return NULL;
+}
+
+/* I/O sweep thread function: random reads of one block size at one queue
+ * depth through one engine, over the random I/O file (kept for the
+ * following cells; main removes it) */
+void* io_sweep_benchmark(void* args) {
+    thread_args_t* t_args = (thread_args_t*)args;
+    char filename[96];
+    random_file_name(filename, sizeof(filename), t_args);
+    
+    bool direct;
+    size_t length = 0;
+    int fd = disk_open_block_file(t_args->thread_id, filename, 0, &direct);
+    bool ok = fd >= 0;
+    if (ok) {
+        length = random_plan_file_size(direct);
+        ok = disk_fill_block_file(t_args->thread_id, fd, length);
+    }
+    if (!ok) {
+        log_message("Thread %d: cannot prepare %s for the I/O sweep: %s", t_args->thread_id, filename,
+                    strerror(errno));
+    }
+    latency_histogram_t* histograms = calloc(3, sizeof(latency_histogram_t));
+    ok = ok && histograms;
+    uring_job_t job;
+    if (ok && io_sweep_engine == IO_ENGINE_URING) {
+        ok = disk_uring_prepare(&job, t_args->thread_id, filename, length, URING_RAND_READ, io_sweep_block,
+                                io_sweep_depth);
+    }
+    double deadline = start_gate_wait(&phase_gate);
+    
+    double iops = 0.0, throughput = 0.0, unused;
+    if (ok && io_sweep_engine == IO_ENGINE_PSYNC) {
+        size_t alignment = direct ? device_logical_block_size(fd) : DIRECT_IO_DEFAULT_ALIGNMENT;
+        ok = disk_benchmark_impl_random(t_args->thread_id, deadline, fd, length, alignment, io_sweep_block, 100,
+                                        &iops, &unused, histograms);
+        throughput = iops * io_sweep_block / (1024 * 1024);
+    } else if (ok) {
+        ok = disk_benchmark_impl_uring(t_args->thread_id, &job, deadline, &throughput, &iops, &histograms[0]);
+        disk_uring_release(&job, t_args->thread_id);
+    }
+    if (fd >= 0) close(fd);
+    
+    pthread_mutex_lock(&results_mutex);
+    t_args->thread_results.io_sweep_iops = iops;
+    t_args->thread_results.io_sweep_throughput = throughput;
+    t_args->completed = ok;
+    if (ok) histogram_merge(&io_sweep_histogram, &histograms[0]);
+    pthread_mutex_unlock(&results_mutex);
+    free(histograms);
+    
+    return NULL;
+}
+
+/* Reduce one metric over a contiguous range of threads.
+ * `offset` is the offsetof() the metric inside benchmark_result_t; threads
+ * that never completed (e.g. failed pthread_create) are skipped. */
+void reduce_thread_metric(const thread_args_t* args, int first, int count,
+                          size_t offset, thread_stats_t* stats) {
+    memset(stats, 0, sizeof(*stats));
+    
+    for (int i = first; i < first + count; i++) {
+        if (!args[i].completed) continue;
+        double value = *(const double*)((const char*)&args[i].thread_results + offset);
+        
+        if (stats->count == 0 || value < stats->min) stats->min = value;
+        if (stats->count == 0 || value > stats->max) stats->max = value;
+        stats->sum += value;
+        stats->count++;
+    }
+    
+    if (stats->count == 0) return;
+    stats->mean = stats->sum / stats->count;
+    
+    double sq_dev = 0.0;
+    for (int i = first; i < first + count; i++) {
+        if (!args[i].completed) continue;
+        double value = *(const double*)((const char*)&args[i].thread_results + offset);
+        sq_dev += (value - stats->mean) * (value - stats->mean);
+    }
+    stats->stddev = sqrt(sq_dev / stats->count);
+}
+
+/* Aggregate per-thread CPU results into the system-wide totals */
+void aggregate_cpu_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, cpu_flops),
+                         &global_thread_stats.cpu_flops);
+    global_results.cpu_flops = global_thread_stats.cpu_flops.sum;
+}
+
+/* Aggregate per-thread peak FLOPS results into the system-wide total */
+void aggregate_cpu_peak_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, cpu_peak_flops),
+                         &global_thread_stats.cpu_peak_flops);
+    global_results.cpu_peak_flops = global_thread_stats.cpu_peak_flops.sum;
+}
+
+/* Aggregate per-thread vectorized transcendental results into the system-wide total */
+void aggregate_cpu_vector_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, cpu_vector_flops),
+                         &global_thread_stats.cpu_vector_flops);
+    global_results.cpu_vector_flops = global_thread_stats.cpu_vector_flops.sum;
+}
+
+/* Aggregate per-thread DGEMM results for one matrix size */
+void aggregate_dgemm_results(const thread_args_t* args, int first, int count, int size_index) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, cpu_dgemm_flops),
+                         &dgemm_stats[size_index]);
+}
+
+/* Aggregate per-thread memory results into the system-wide totals */
+void aggregate_memory_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, memory_read_bandwidth),
+                         &global_thread_stats.memory_read_bandwidth);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, memory_write_bandwidth),
+                         &global_thread_stats.memory_write_bandwidth);
+    global_results.memory_read_bandwidth = global_thread_stats.memory_read_bandwidth.sum;
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, memory_nt_write_bandwidth),
+                         &global_thread_stats.memory_nt_write_bandwidth);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, memory_touch_bandwidth),
+                         &global_thread_stats.memory_touch_bandwidth);
+    global_results.memory_write_bandwidth = global_thread_stats.memory_write_bandwidth.sum;
+    global_results.memory_nt_write_bandwidth = global_thread_stats.memory_nt_write_bandwidth.sum;
+    global_results.memory_touch_bandwidth = global_thread_stats.memory_touch_bandwidth.sum;
+}
+
+/* Aggregate per-thread STREAM results into the system-wide totals */
+void aggregate_stream_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, stream_copy_bandwidth),
+                         &global_thread_stats.stream_copy_bandwidth);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, stream_scale_bandwidth),
+                         &global_thread_stats.stream_scale_bandwidth);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, stream_add_bandwidth),
+                         &global_thread_stats.stream_add_bandwidth);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, stream_triad_bandwidth),
+                         &global_thread_stats.stream_triad_bandwidth);
+    global_results.stream_copy_bandwidth = global_thread_stats.stream_copy_bandwidth.sum;
+    global_results.stream_scale_bandwidth = global_thread_stats.stream_scale_bandwidth.sum;
+    global_results.stream_add_bandwidth = global_thread_stats.stream_add_bandwidth.sum;
+    global_results.stream_triad_bandwidth = global_thread_stats.stream_triad_bandwidth.sum;
+}
+
+/* Aggregate per-thread disk results into the system-wide totals */
+void aggregate_disk_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, disk_read_throughput),
+                         &global_thread_stats.disk_read_throughput);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, disk_write_throughput),
+                         &global_thread_stats.disk_write_throughput);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, disk_seek_iops),
+                         &global_thread_stats.disk_seek_iops);
+    global_results.disk_read_throughput = global_thread_stats.disk_read_throughput.sum;
+    global_results.disk_write_throughput = global_thread_stats.disk_write_throughput.sum;
+    global_results.disk_seek_iops = global_thread_stats.disk_seek_iops.sum;
+}
+
+/* Aggregate per-thread O_DIRECT results into the system-wide totals */
+void aggregate_direct_results(const thread_args_t* args, int first, int count) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, direct_read_throughput),
+                         &global_thread_stats.direct_read_throughput);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, direct_write_throughput),
+                         &global_thread_stats.direct_write_throughput);
+    global_results.direct_read_throughput = global_thread_stats.direct_read_throughput.sum;
+    global_results.direct_write_throughput = global_thread_stats.direct_write_throughput.sum;
+}
+
+/* Aggregate per-thread random I/O results for one profile */
+void aggregate_random_results(const thread_args_t* args, int first, int count, random_profile_t profile) {
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, random_read_iops),
+                         &random_read_stats[profile]);
+    reduce_thread_metric(args, first, count, offsetof(benchmark_result_t, random_write_iops),
+                         &random_write_stats[profile]);
+}
+
+/* Calculate benchmark scores */
+void calculate_benchmark_scores() {
+    // Calculate individual component scores (1000 points = reference system)
+    
+    // CPU Score: based on FLOPS performance relative to reference
+    double cpu_ratio = global_results.cpu_flops / CPU_REFERENCE_FLOPS;
+    global_results.cpu_score = (int)(1000 * cpu_ratio);
+    
     // Memory Score: average of read and write bandwidth scores
     double mem_read_ratio = global_results.memory_read_bandwidth / MEMORY_READ_REFERENCE;
     double mem_write_ratio = global_results.memory_write_bandwidth / MEMORY_WRITE_REFERENCE;
@@ -447,18 +4045,427 @@ void cleanup_resources(thread_args_t* args, int count, pthread_t* threads) {
                 free(args[i].thread_buffer);
             }
         }
-        free(args);
+        free(args);
+    }
+    
+    // Free threads array
+    if (threads) {
+        free(threads);
+    }
+    
+    // Destroy mutexes
+    pthread_mutex_destroy(&log_mutex);
+    pthread_mutex_destroy(&results_mutex);
+    pthread_mutex_destroy(&phase_gate.mutex);
+    pthread_cond_destroy(&phase_gate.cond);
+    verbose_log("Resource cleanup complete");
+}
+
+/* Hardware performance counters (--perf). Each benchmark thread gets one
+ * perf_event_open() group counting its work from the start gate until the
+ * thread function returns; groups are summed per phase name, so every step
+ * of a sweep adds to the same entry. Kernel work is counted too unless
+ * perf_event_paranoid forbids it, in which case every event falls back to
+ * user space only. Events the CPU, hypervisor or perf_event_paranoid refuse
+ * are left out and their ratios reported as unavailable. */
+typedef enum {
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_TASK_CLOCK,                   // ns on CPU, for the effective frequency
+    PERF_NUM_EVENTS
+} perf_event_id_t;
+
+#define PERF_MAX_PHASES 64
+
+typedef struct {
+    char name[32];
+    int threads;                       // Thread groups summed into counts
+    bool counted[PERF_NUM_EVENTS];     // Event opened in at least one group
+    double counts[PERF_NUM_EVENTS];
+} perf_phase_t;
+
+/* Trampoline argument: the phase routine and its own argument */
+typedef struct {
+    void* (*routine)(void*);
+    void* arg;
+} perf_thread_t;
+
+const char* const perf_event_names[PERF_NUM_EVENTS] = {
+    "cycles", "instructions", "LLC-misses", "branch-misses", "dTLB-load-misses", "task-clock"};
+perf_phase_t perf_phases[PERF_MAX_PHASES];
+int perf_num_phases = 0;
+perf_phase_t perf_current;             // Phase being measured
+pthread_mutex_t perf_mutex = PTHREAD_MUTEX_INITIALIZER;
+int perf_open_errno = 0;               // Why the first refused event failed
+bool perf_user_only = false;           // Kernel excluded: set by the first refusal, before any phase
+
+#ifdef HAVE_PERF_EVENTS
+/* perf_event_attr of one event: this thread, opened disabled */
+void perf_event_attr_for(perf_event_id_t event, bool user_only, struct perf_event_attr* attr) {
+    memset(attr, 0, sizeof(*attr));
+    attr->size = sizeof(*attr);
+    attr->type = PERF_TYPE_HARDWARE;
+    switch (event) {
+        case PERF_CYCLES: attr->config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case PERF_INSTRUCTIONS: attr->config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case PERF_LLC_MISSES: attr->config = PERF_COUNT_HW_CACHE_MISSES; break;
+        case PERF_BRANCH_MISSES: attr->config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case PERF_DTLB_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        default:
+            attr->type = PERF_TYPE_SOFTWARE;
+            attr->config = PERF_COUNT_SW_TASK_CLOCK;
+            break;
+    }
+    attr->disabled = 1;
+    attr->exclude_kernel = user_only;
+    attr->exclude_hv = 1;
+    attr->read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+}
+#endif
+
+/* Open the calling thread's counter group; `order` receives the event of
+ * each group member in read order. Returns the number of members. */
+int perf_open_group(int* fds, perf_event_id_t* order) {
+    int members = 0;
+#ifdef HAVE_PERF_EVENTS
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        struct perf_event_attr attr;
+        perf_event_attr_for((perf_event_id_t)e, perf_user_only, &attr);
+        int leader = members ? fds[0] : -1;
+        int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, leader, 0);
+        if (fd < 0 && !perf_user_only && (errno == EACCES || errno == EPERM)) {
+            // Kernel counting refused: restart the whole group in user space
+            // so all its events cover the same work
+            perf_user_only = true;
+            for (int m = 0; m < members; m++) close(fds[m]);
+            members = 0;
+            e = -1;
+            continue;
+        }
+        if (fd < 0) {
+            if (perf_open_errno == 0) perf_open_errno = errno;
+            continue;
+        }
+        fds[members] = fd;
+        order[members++] = (perf_event_id_t)e;
+    }
+#else
+    (void)fds; (void)order;
+#endif
+    return members;
+}
+
+/* Stop and read a group into perf_current, scaling for multiplexing */
+void perf_close_group(int* fds, const perf_event_id_t* order, int members) {
+#ifdef HAVE_PERF_EVENTS
+    ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    uint64_t data[3 + PERF_NUM_EVENTS];
+    ssize_t got = read(fds[0], data, sizeof(data));
+    if (got >= (ssize_t)(3 * sizeof(uint64_t)) && data[0] == (uint64_t)members && data[2] > 0) {
+        double scale = (double)data[1] / (double)data[2];
+        pthread_mutex_lock(&perf_mutex);
+        perf_current.threads++;
+        for (int m = 0; m < members; m++) {
+            perf_current.counted[order[m]] = true;
+            perf_current.counts[order[m]] += (double)data[3 + m] * scale;
+        }
+        pthread_mutex_unlock(&perf_mutex);
+    }
+#else
+    (void)order;
+#endif
+    for (int m = 0; m < members; m++) close(fds[m]);
+}
+
+/* Thread entry under --perf: counters around the phase routine */
+void* perf_thread_main(void* arg) {
+    perf_thread_t* thread = (perf_thread_t*)arg;
+    int fds[PERF_NUM_EVENTS];
+    perf_event_id_t order[PERF_NUM_EVENTS];
+    int members = perf_open_group(fds, order);
+    perf_thread_group = members ? fds[0] : -1;
+    
+    void* result = thread->routine(thread->arg);
+    
+    if (members) perf_close_group(fds, order, members);
+    perf_thread_group = -1;
+    return result;
+}
+
+/* Open and close a group on the calling thread to list the events this
+ * system grants */
+void perf_probe(char* text, size_t len) {
+    int fds[PERF_NUM_EVENTS];
+    perf_event_id_t order[PERF_NUM_EVENTS];
+    int members = perf_open_group(fds, order);
+    size_t used = 0;
+    text[0] = '\0';
+    for (int m = 0; m < members && used < len; m++) {
+        used += snprintf(text + used, len - used, "%s%s", m ? ", " : "", perf_event_names[order[m]]);
+    }
+    for (int m = 0; m < members; m++) close(fds[m]);
+    if (members && perf_user_only && used < len) {
+        used += snprintf(text + used, len - used, " in user space only");
+    }
+    if (members < PERF_NUM_EVENTS && used < len) {
+        snprintf(text + used, len - used, "%s(%d of %d events refused: %s)", members ? " " : "",
+                 PERF_NUM_EVENTS - members, PERF_NUM_EVENTS,
+                 perf_open_errno ? strerror(perf_open_errno) : "not supported by this build");
+    }
+}
+
+/* Derived metrics of a phase: IPC, misses per kilo-instruction, GHz. With
+ * kernel work excluded the ratios are labelled user-space, and GHz is left
+ * out because task-clock still includes the time spent in the kernel. */
+void perf_describe(const perf_phase_t* phase, char* text, size_t len) {
+    const double* c = phase->counts;
+    bool have_instructions = phase->counted[PERF_INSTRUCTIONS] && c[PERF_INSTRUCTIONS] > 0;
+    size_t used = 0;
+    text[0] = '\0';
+    if (perf_user_only && have_instructions) {
+        used += snprintf(text + used, len - used, "user-space ");
+    }
+    if (have_instructions && phase->counted[PERF_CYCLES] && c[PERF_CYCLES] > 0) {
+        used += snprintf(text + used, len - used, "IPC %.2f, ", c[PERF_INSTRUCTIONS] / c[PERF_CYCLES]);
+    }
+    const perf_event_id_t misses[3] = {PERF_LLC_MISSES, PERF_BRANCH_MISSES, PERF_DTLB_MISSES};
+    const char* const labels[3] = {"LLC", "branch", "dTLB"};
+    for (int m = 0; m < 3 && have_instructions && used < len; m++) {
+        if (!phase->counted[misses[m]]) continue;
+        used += snprintf(text + used, len - used, "%s %.2f MPKI, ", labels[m],
+                         c[misses[m]] * 1000.0 / c[PERF_INSTRUCTIONS]);
+    }
+    if (!perf_user_only && phase->counted[PERF_CYCLES] && phase->counted[PERF_TASK_CLOCK] &&
+        c[PERF_TASK_CLOCK] > 0 && used < len) {
+        used += snprintf(text + used, len - used, "%.2f GHz, ", c[PERF_CYCLES] / c[PERF_TASK_CLOCK]);
+    }
+    if (phase->counted[PERF_TASK_CLOCK] && used < len) {
+        used += snprintf(text + used, len - used, "%.2f s on CPU, ", c[PERF_TASK_CLOCK] / BILLION);
+    }
+    if (used >= 2 && used < len) {
+        text[used - 2] = '\0';
+    } else if (used == 0) {
+        snprintf(text, len, "no counters available");
+    }
+}
+
+/* Add perf_current to the entry of its phase name and log its ratios */
+void perf_finish_phase(const char* name) {
+    if (perf_current.threads == 0) return;
+    perf_phase_t* phase = NULL;
+    for (int p = 0; p < perf_num_phases && !phase; p++) {
+        if (strcmp(perf_phases[p].name, name) == 0) phase = &perf_phases[p];
+    }
+    if (!phase && perf_num_phases < PERF_MAX_PHASES) {
+        phase = &perf_phases[perf_num_phases++];
+        snprintf(phase->name, sizeof(phase->name), "%s", name);
+    }
+    if (!phase) return;
+    phase->threads += perf_current.threads;
+    for (int e = 0; e < PERF_NUM_EVENTS; e++) {
+        phase->counted[e] |= perf_current.counted[e];
+        phase->counts[e] += perf_current.counts[e];
+    }
+    char text[160];
+    perf_describe(&perf_current, text, sizeof(text));
+    log_message("perf %s: %s", name, text);
+}
+
+/* Run one benchmark phase: spawn `count` workers on args[first..], release
+ * them through the start gate into a common measurement window of `seconds`
+ * and join them. Returns the number of threads that were created. */
+int run_benchmark_phase_for(pthread_t* threads, thread_args_t* args, int first, int count,
+                            void* (*routine)(void*), const char* name, double seconds) {
+    int created = 0;
+    perf_thread_t* perf_threads = run_perf ? calloc(count, sizeof(perf_thread_t)) : NULL;
+    memset(&perf_current, 0, sizeof(perf_current));
+    start_gate_reset(&phase_gate);
+    for (int i = first; i < first + count; i++) {
+        args[i].completed = false;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        int idx = first + i;
+        pthread_attr_t attr;
+        pthread_attr_t* attr_ptr = affinity_thread_attr(&attr, i);
+        int rc;
+        if (perf_threads) {
+            perf_threads[i] = (perf_thread_t){routine, &args[idx]};
+            rc = pthread_create(&threads[idx], attr_ptr, perf_thread_main, &perf_threads[i]);
+        } else {
+            rc = pthread_create(&threads[idx], attr_ptr, routine, &args[idx]);
+        }
+        if (attr_ptr) pthread_attr_destroy(attr_ptr);
+        if (rc != 0) {
+            log_message("Failed to create %s benchmark thread %d: %s", name, i, strerror(rc));
+            running = false;  // Threads already waiting at the gate exit immediately
+            break;
+        }
+        created++;
+    }
+    
+    start_gate_open(&phase_gate, created, seconds);
+    
+    for (int i = 0; i < created; i++) {
+        pthread_join(threads[first + i], NULL);
+    }
+    if (perf_threads) perf_finish_phase(name);
+    free(perf_threads);
+    return created;
+}
+
+/* Run one benchmark phase over the full test duration */
+int run_benchmark_phase(pthread_t* threads, thread_args_t* args, int first, int count,
+                        void* (*routine)(void*), const char* name) {
+    return run_benchmark_phase_for(threads, args, first, count, routine, name, duration);
+}
+
+/* Window for one step of a multi-step sweep: the test duration split
+ * across the steps, but never below one second */
+double sweep_step_seconds(int steps) {
+    double seconds = (double)duration / steps;
+    return (seconds < 1.0) ? 1.0 : seconds;
+}
+
+/* Repeated trials (--trials) of the scored phases. After trial_warmup
+ * discarded runs a phase runs num_trials times, and then again until the CV
+ * of each of its metrics is below trial_cv_target or trial_max runs were
+ * made. Outliers (modified z-score above 3.5) are rejected before the
+ * statistics; the scored value becomes the trial mean, while the
+ * per-thread distribution is that of the last trial. */
+#define TRIALS_MAX 100
+#define TRIAL_NUM_METRICS 6
+#define TRIAL_OUTLIER_Z 3.5
+
+typedef struct {
+    const char* name;
+    const char* unit;
+    double scale;                      // Display divisor
+    size_t offset;                     // offsetof() the total in benchmark_result_t
+    int count;
+    double samples[TRIALS_MAX];
+    int rejected;                      // Samples rejected as outliers
+    double mean;
+    double median;
+    double stddev;                     // Sample standard deviation of the kept samples
+    double cv;                         // Coefficient of variation in percent
+    double ci_low;                     // 95% confidence interval of the mean
+    double ci_high;
+} trial_metric_t;
+
+trial_metric_t trial_metrics[TRIAL_NUM_METRICS] = {
+    {.name = "CPU FLOPS", .unit = "MFLOPS", .scale = 1000000.0,
+     .offset = offsetof(benchmark_result_t, cpu_flops)},
+    {.name = "Memory Read", .unit = "MB/s", .scale = 1.0,
+     .offset = offsetof(benchmark_result_t, memory_read_bandwidth)},
+    {.name = "Memory Write", .unit = "MB/s", .scale = 1.0,
+     .offset = offsetof(benchmark_result_t, memory_write_bandwidth)},
+    {.name = "Disk Read", .unit = "MB/s", .scale = 1.0,
+     .offset = offsetof(benchmark_result_t, disk_read_throughput)},
+    {.name = "Disk Write", .unit = "MB/s", .scale = 1.0,
+     .offset = offsetof(benchmark_result_t, disk_write_throughput)},
+    {.name = "Disk Random", .unit = "IOPS", .scale = 1.0,
+     .offset = offsetof(benchmark_result_t, disk_seek_iops)},
+};
+
+/* Two-sided 97.5% Student t quantiles for 1..30 degrees of freedom */
+const double student_t_975[30] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+
+int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/* Median of `count` values (sorted in place) */
+double median_of(double* values, int count) {
+    qsort(values, count, sizeof(double), compare_doubles);
+    return (count % 2) ? values[count / 2] : (values[count / 2 - 1] + values[count / 2]) / 2;
+}
+
+/* Recompute the statistics of a metric from its samples */
+void trial_summarize(trial_metric_t* metric) {
+    int n = metric->count;
+    double sorted[TRIALS_MAX], deviations[TRIALS_MAX], kept[TRIALS_MAX];
+    memcpy(sorted, metric->samples, n * sizeof(double));
+    metric->median = median_of(sorted, n);
+    
+    // Median absolute deviation; with MAD = 0 nothing is rejected
+    for (int i = 0; i < n; i++) deviations[i] = fabs(metric->samples[i] - metric->median);
+    double mad = median_of(deviations, n);
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        if (mad > 0 && 0.6745 * fabs(metric->samples[i] - metric->median) / mad > TRIAL_OUTLIER_Z) continue;
+        kept[k++] = metric->samples[i];
+    }
+    metric->rejected = n - k;
+    
+    double sum = 0, sq_dev = 0;
+    for (int i = 0; i < k; i++) sum += kept[i];
+    metric->mean = (k > 0) ? sum / k : 0;
+    for (int i = 0; i < k; i++) sq_dev += (kept[i] - metric->mean) * (kept[i] - metric->mean);
+    metric->stddev = (k > 1) ? sqrt(sq_dev / (k - 1)) : 0;
+    metric->cv = (metric->mean > 0) ? 100.0 * metric->stddev / metric->mean : 0;
+    double t = (k > 31) ? 1.96 : (k > 1) ? student_t_975[k - 2] : 0;
+    double half_width = (k > 1) ? t * metric->stddev / sqrt(k) : 0;
+    metric->ci_low = metric->mean - half_width;
+    metric->ci_high = metric->mean + half_width;
+}
+
+/* Run a scored phase under the trials policy. `aggregate` folds the
+ * threads' results into global_results; metrics[] are the totals sampled
+ * after every trial. Returns the threads created by the last run. */
+int run_phase_trials(pthread_t* threads, thread_args_t* args, int first, int count,
+                     void* (*routine)(void*), const char* name,
+                     void (*aggregate)(const thread_args_t*, int, int),
+                     trial_metric_t* metrics, int num_metrics) {
+    if (num_trials <= 1) {
+        int created = run_benchmark_phase(threads, args, first, count, routine, name);
+        aggregate(args, first, count);
+        return created;
+    }
+    
+    for (int w = 0; w < trial_warmup && running; w++) {
+        run_benchmark_phase(threads, args, first, count, routine, name);
+        log_message("%s warmup run %d discarded", name, w + 1);
+    }
+    
+    int limit = (trial_max > 0) ? trial_max : 3 * num_trials;
+    if (limit < num_trials) limit = num_trials;
+    if (limit > TRIALS_MAX) limit = TRIALS_MAX;
+    int created = 0;
+    for (int t = 0; t < limit && running; t++) {
+        created = run_benchmark_phase(threads, args, first, count, routine, name);
+        aggregate(args, first, count);
+        
+        double worst_cv = 0;
+        for (int m = 0; m < num_metrics; m++) {
+            metrics[m].samples[metrics[m].count++] = *(double*)((char*)&global_results + metrics[m].offset);
+            trial_summarize(&metrics[m]);
+            if (metrics[m].cv > worst_cv) worst_cv = metrics[m].cv;
+        }
+        log_message("%s trial %d: CV %.2f%%", name, t + 1, worst_cv);
+        if (created < count) break;
+        if (t + 1 >= num_trials && (trial_cv_target <= 0 || worst_cv <= trial_cv_target)) break;
+        if (t + 1 == limit) {
+            log_message("%s: CV still %.2f%% after %d trials (target %.2f%%)", name, worst_cv, limit,
+                        trial_cv_target);
+        }
     }
     
-    // Free threads array
-    if (threads) {
-        free(threads);
+    for (int m = 0; m < num_metrics; m++) {
+        if (metrics[m].count > 0) *(double*)((char*)&global_results + metrics[m].offset) = metrics[m].mean;
     }
-    
-    // Destroy mutexes
-    pthread_mutex_destroy(&log_mutex);
-    pthread_mutex_destroy(&results_mutex);
-    verbose_log("Resource cleanup complete");
+    return created;
 }
 
 /* Parse command line arguments */
@@ -476,10 +4483,151 @@ void parse_arguments(int argc, char* argv[]) {
             file_size = (size_t)atoll(argv[i + 1]) * 1024 * 1024;  // Convert MB to bytes
             if (file_size == 0) file_size = DEFAULT_FILE_SIZE;
             i++;
+        } else if (strcmp(argv[i], "--io-block") == 0 && i + 1 < argc) {
+            io_block_size = (size_t)atoll(argv[i + 1]) * 1024;  // Convert KB to bytes
+            if (io_block_size == 0) io_block_size = DEFAULT_IO_BLOCK_SIZE;
+            i++;
+        } else if (strcmp(argv[i], "--rand-block") == 0 && i + 1 < argc) {
+            random_block_size = (size_t)atoll(argv[i + 1]) * 1024;  // Convert KB to bytes
+            if (random_block_size == 0) random_block_size = DEFAULT_RANDOM_BLOCK_SIZE;
+            i++;
+        } else if (strcmp(argv[i], "--rand-file") == 0 && i + 1 < argc) {
+            random_file_size = (size_t)atoll(argv[i + 1]) * 1024 * 1024;  // Convert MB to bytes
+            i++;
+        } else if (strcmp(argv[i], "--read-pct") == 0 && i + 1 < argc) {
+            random_read_percent = atoi(argv[i + 1]);
+            if (random_read_percent < 0 || random_read_percent > 100) random_read_percent = 70;
+            i++;
+        } else if (strcmp(argv[i], "--sync") == 0 && i + 1 < argc) {
+            if (strcmp(argv[i + 1], "dsync") == 0) {
+                random_sync_mode = SYNC_DSYNC;
+            } else if (atoll(argv[i + 1]) > 0) {
+                random_sync_mode = SYNC_FDATASYNC;
+                random_sync_every = atoll(argv[i + 1]);
+            } else {
+                random_sync_mode = SYNC_NONE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--uring-qd") == 0 && i + 1 < argc) {
+            int count = 0;
+            for (char* p = argv[i + 1]; *p && count < URING_MAX_QUEUE_DEPTHS; ) {
+                char* end;
+                long depth = strtol(p, &end, 10);
+                if (end == p) break;
+                if (depth > 0 && depth <= 4096) uring_queue_depths[count++] = (int)depth;
+                p = (*end == ',') ? end + 1 : end;
+            }
+            if (count > 0) uring_num_queue_depths = count;
+            i++;
         } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
             duration = atoi(argv[i + 1]);
             if (duration <= 0) duration = DEFAULT_TEST_DURATION;
             i++;
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            if (strcmp(argv[i + 1], "bursty") == 0) {
+                load_profile = LOAD_PROFILE_BURSTY;
+            } else {
+                load_profile = LOAD_PROFILE_CONTINUOUS;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--slice") == 0 && i + 1 < argc) {
+            slice_ms = atoi(argv[i + 1]);
+            if (slice_ms <= 0) slice_ms = DEFAULT_SLICE_MS;
+            i++;
+        } else if (strcmp(argv[i], "--affinity") == 0 && i + 1 < argc) {
+            const char* policy = argv[i + 1];
+            if (strcmp(policy, "compact") == 0) {
+                affinity_policy = AFFINITY_COMPACT;
+            } else if (strcmp(policy, "scatter") == 0) {
+                affinity_policy = AFFINITY_SCATTER;
+            } else if (strcmp(policy, "physical") == 0) {
+                affinity_policy = AFFINITY_PHYSICAL;
+            } else if (policy[0] >= '0' && policy[0] <= '9') {
+                affinity_policy = AFFINITY_LIST;
+                affinity_cpu_list = policy;
+            } else {
+                affinity_policy = AFFINITY_NONE;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--pages") == 0 && i + 1 < argc) {
+            memory_page_backing = PAGE_BACKING_DEFAULT;
+            for (int b = 0; b < PAGE_BACKING_COUNT; b++) {
+                if (strcasecmp(argv[i + 1], page_backing_names[b]) == 0) memory_page_backing = (page_backing_t)b;
+            }
+            i++;
+        } else if (strcmp(argv[i], "--direct") == 0) {
+            run_direct_io = true;
+        } else if (strcmp(argv[i], "--randread") == 0) {
+            run_random_profile[RANDOM_PROFILE_READ] = true;
+        } else if (strcmp(argv[i], "--randwrite") == 0) {
+            run_random_profile[RANDOM_PROFILE_WRITE] = true;
+        } else if (strcmp(argv[i], "--mixed") == 0) {
+            run_random_profile[RANDOM_PROFILE_MIXED] = true;
+        } else if (strcmp(argv[i], "--trials") == 0 && i + 1 < argc) {
+            num_trials = atoi(argv[i + 1]);
+            if (num_trials < 1) num_trials = 1;
+            if (num_trials > TRIALS_MAX) num_trials = TRIALS_MAX;
+            i++;
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            trial_warmup = atoi(argv[i + 1]);
+            if (trial_warmup < 0) trial_warmup = 0;
+            i++;
+        } else if (strcmp(argv[i], "--max-trials") == 0 && i + 1 < argc) {
+            trial_max = atoi(argv[i + 1]);
+            if (trial_max < 0) trial_max = 0;
+            i++;
+        } else if (strcmp(argv[i], "--cv") == 0 && i + 1 < argc) {
+            trial_cv_target = atof(argv[i + 1]);
+            i++;
+        } else if (strcmp(argv[i], "--perf") == 0) {
+            run_perf = true;
+        } else if (strcmp(argv[i], "--io-sweep") == 0) {
+            run_io_sweep = true;
+        } else if (strcmp(argv[i], "--mmap") == 0) {
+            run_mmap = true;
+        } else if (strcmp(argv[i], "--commit") == 0) {
+            run_commit = true;
+        } else if (strcmp(argv[i], "--group") == 0 && i + 1 < argc) {
+            commit_group_size = atoi(argv[i + 1]);
+            if (commit_group_size < 2) commit_group_size = 8;
+            i++;
+        } else if (strcmp(argv[i], "--uring") == 0) {
+            run_uring = true;
+        } else if (strcmp(argv[i], "--sqpoll") == 0) {
+            uring_sqpoll = true;
+        } else if (strcmp(argv[i], "--uring-fixed") == 0) {
+            uring_fixed = true;
+        } else if (strcmp(argv[i], "--page-sizes") == 0) {
+            run_page_sizes = true;
+        } else if (strcmp(argv[i], "--peak-flops") == 0) {
+            run_peak_flops = true;
+        } else if (strcmp(argv[i], "--vector-math") == 0) {
+            run_vector_math = true;
+        } else if (strcmp(argv[i], "--dgemm") == 0) {
+            run_dgemm = true;
+        } else if (strcmp(argv[i], "--stream") == 0) {
+            run_stream = true;
+        } else if (strcmp(argv[i], "--latency") == 0) {
+            run_latency = true;
+        } else if (strcmp(argv[i], "--cache-sweep") == 0) {
+            run_cache_sweep = true;
+        } else if (strcmp(argv[i], "--numa") == 0) {
+            run_numa = true;
+        } else if (strcmp(argv[i], "-x") == 0 || strcmp(argv[i], "--extended") == 0) {
+            run_numa = true;
+            run_page_sizes = true;
+            run_direct_io = true;
+            run_uring = true;
+            run_commit = true;
+            run_mmap = true;
+            run_io_sweep = true;
+            for (int p = 0; p < RANDOM_NUM_PROFILES; p++) run_random_profile[p] = true;
+            run_cache_sweep = true;
+            run_latency = true;
+            run_stream = true;
+            run_peak_flops = true;
+            run_vector_math = true;
+            run_dgemm = true;
         } else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
             verbose_output = true;
         } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
@@ -490,7 +4638,58 @@ void parse_arguments(int argc, char* argv[]) {
                    (int)(DEFAULT_MEMORY_BLOCK_SIZE / (1024 * 1024)));
             printf("  -f SIZE      File size in MB (default: %d MB)\n", 
                    (int)(DEFAULT_FILE_SIZE / (1024 * 1024)));
+            printf("  --io-block KB Request size of the block-based disk tests (default: %d KB)\n",
+                   DEFAULT_IO_BLOCK_SIZE / 1024);
+            printf("  --rand-block KB Request size of the random disk tests (default: %d KB)\n",
+                   DEFAULT_RANDOM_BLOCK_SIZE / 1024);
+            printf("  --rand-file MB Per-thread file of the random I/O tests (default: 1 GB with\n");
+            printf("               O_DIRECT, 4x the thread's share of RAM when buffered)\n");
+            printf("  --read-pct N Share of reads in --mixed (default: 70)\n");
+            printf("  --sync S     Random writes: none (default), dsync (O_DSYNC) or N\n");
+            printf("               (fdatasync every N writes)\n");
             printf("  -d SECONDS   Test duration in seconds (default: %d)\n", DEFAULT_TEST_DURATION);
+            printf("  --profile P  Load profile: continuous (calibrated, no sleeps) or bursty\n");
+            printf("               (fixed batches with %d ms pauses) (default: continuous)\n",
+                   BURSTY_PAUSE_US / 1000);
+            printf("  --slice MS   Continuous-load batch target in ms (default: %d)\n", DEFAULT_SLICE_MS);
+            printf("  --affinity P Pin each phase's threads: compact, scatter (across sockets),\n");
+            printf("               physical (one per physical core), a CPU list such as 0-3,8,\n");
+            printf("               or none (default)\n");
+            printf("  --pages P    Memory test page backing: default, 4K, THP, 2M or 1G\n");
+            printf("               (hugetlbfs; falls back to the next smaller backing)\n");
+            printf("  --peak-flops Also run the vectorized FMA peak FLOPS kernel\n");
+            printf("  --vector-math Also run the FLOPS workload with vectorized sin/cos/sqrt\n");
+            printf("  --dgemm      Also run the cache-blocked DGEMM matrix size sweep\n");
+            printf("  --stream     Also run the STREAM Copy/Scale/Add/Triad kernels\n");
+            printf("  --latency    Also run the pointer-chase memory latency sweep\n");
+            printf("  --cache-sweep Also sweep read/write bandwidth over L1..DRAM buffer sizes\n");
+            printf("  --numa       Pin memory threads per NUMA node with node-local buffers and\n");
+            printf("               also measure the node-to-node bandwidth/latency matrix\n");
+            printf("  --page-sizes Also compare bandwidth/latency across every page backing\n");
+            printf("  --direct     Also measure sequential disk throughput with O_DIRECT\n");
+            printf("  --randread   Also measure random-read IOPS over a large preallocated file\n");
+            printf("  --randwrite  Also measure random-write IOPS on the same file\n");
+            printf("  --mixed      Also measure a mixed random read/write profile\n");
+            printf("  --io-sweep   Also sweep random reads over 4 KB-1 MB blocks and queue depths\n");
+            printf("               1-256 for each I/O engine (psync at depth 1, io_uring)\n");
+            printf("  --mmap       Also compare mmap (faulted, MAP_POPULATE) with read()/pread()/\n");
+            printf("               pwrite() for sequential scans, random reads and writes\n");
+            printf("  --commit     Also measure fdatasync commit latency of appended 512 B-64 KB\n");
+            printf("               records, one sync per record and per --group records\n");
+            printf("  --group K    Records per sync of the group-commit variant (default: 8)\n");
+            printf("  --uring      Also run io_uring sequential/random read/write at several\n");
+            printf("               queue depths per thread\n");
+            printf("  --uring-qd L Queue depths for --uring, e.g. 1,8,32 (default)\n");
+            printf("  --sqpoll     io_uring: kernel submission polling thread (SQPOLL)\n");
+            printf("  --uring-fixed io_uring: registered buffers and files\n");
+            printf("  -x, --extended Run every extended (unscored) test\n");
+            printf("  --trials N   Run the scored phases N times (each for the full duration) and\n");
+            printf("               report mean, median, stddev, CV and 95%% CI (default: 1)\n");
+            printf("  --warmup N   Discarded runs before the trials (default: 1)\n");
+            printf("  --cv PCT     Add trials until the CV is below PCT, 0 = never (default: 2)\n");
+            printf("  --max-trials N Limit for added trials (default: 3x --trials)\n");
+            printf("  --perf       Count cycles, instructions, LLC/branch/dTLB misses per thread\n");
+            printf("               (perf_event_open) and report IPC, MPKI and GHz per phase\n");
             printf("  -v, --verbose Enable verbose output\n");
             printf("  -h, --help   Show this help message\n");
             exit(0);
@@ -498,6 +4697,406 @@ void parse_arguments(int argc, char* argv[]) {
     }
 }
 
+/* Write the trial statistics of every scored metric */
+void fprint_trials(FILE* out) {
+    for (int m = 0; m < TRIAL_NUM_METRICS; m++) {
+        const trial_metric_t* t = &trial_metrics[m];
+        if (t->count == 0) continue;
+        fprintf(out, "  %-13s n=%-3d rejected=%d mean=%.2f median=%.2f stddev=%.2f CV=%.2f%% "
+                     "95%% CI=[%.2f, %.2f] %s\n",
+                t->name, t->count, t->rejected, t->mean / t->scale, t->median / t->scale, t->stddev / t->scale,
+                t->cv, t->ci_low / t->scale, t->ci_high / t->scale, t->unit);
+    }
+}
+
+/* Write the counter-derived metrics of every phase */
+void fprint_perf_phases(FILE* out) {
+    if (perf_num_phases == 0) {
+        fprintf(out, "  unavailable: %s\n", perf_open_errno ? strerror(perf_open_errno) : "no counters");
+        return;
+    }
+    for (int p = 0; p < perf_num_phases; p++) {
+        char text[160];
+        perf_describe(&perf_phases[p], text, sizeof(text));
+        fprintf(out, "  %-12s %s\n", perf_phases[p].name, text);
+    }
+}
+
+/* Write one per-thread distribution line (sum is the scored value) */
+void fprint_thread_stats(FILE* out, const char* label, const char* unit,
+                         double scale, const thread_stats_t* stats) {
+    fprintf(out, "  %-22s threads=%-3d sum=%.2f min=%.2f max=%.2f mean=%.2f stddev=%.2f %s\n",
+            label, stats->count, stats->sum / scale, stats->min / scale, stats->max / scale,
+            stats->mean / scale, stats->stddev / scale, unit);
+}
+
+/* Write the per-thread distribution of every metric */
+void fprint_all_thread_stats(FILE* out) {
+    fprint_thread_stats(out, "CPU FLOPS:", "MFLOPS", 1000000.0, &global_thread_stats.cpu_flops);
+    if (run_peak_flops) {
+        fprint_thread_stats(out, "CPU Peak FLOPS:", "GFLOPS", BILLION, &global_thread_stats.cpu_peak_flops);
+    }
+    if (run_vector_math) {
+        fprint_thread_stats(out, "CPU Vector Math:", "MFLOPS", 1000000.0, &global_thread_stats.cpu_vector_flops);
+    }
+    fprint_thread_stats(out, "Memory Read:", "MB/s", 1.0, &global_thread_stats.memory_read_bandwidth);
+    fprint_thread_stats(out, "Memory Write:", "MB/s", 1.0, &global_thread_stats.memory_write_bandwidth);
+    fprint_thread_stats(out, "Memory NT Write:", "MB/s", 1.0, &global_thread_stats.memory_nt_write_bandwidth);
+    fprint_thread_stats(out, "Memory Touch:", "MB/s", 1.0, &global_thread_stats.memory_touch_bandwidth);
+    if (run_stream) {
+        fprint_thread_stats(out, "STREAM Copy:", "MB/s", 1.0, &global_thread_stats.stream_copy_bandwidth);
+        fprint_thread_stats(out, "STREAM Scale:", "MB/s", 1.0, &global_thread_stats.stream_scale_bandwidth);
+        fprint_thread_stats(out, "STREAM Add:", "MB/s", 1.0, &global_thread_stats.stream_add_bandwidth);
+        fprint_thread_stats(out, "STREAM Triad:", "MB/s", 1.0, &global_thread_stats.stream_triad_bandwidth);
+    }
+    fprint_thread_stats(out, "Disk Read:", "MB/s", 1.0, &global_thread_stats.disk_read_throughput);
+    fprint_thread_stats(out, "Disk Write:", "MB/s", 1.0, &global_thread_stats.disk_write_throughput);
+    fprint_thread_stats(out, "Disk Random Access:", "IOPS", 1.0, &global_thread_stats.disk_seek_iops);
+    if (run_random_profile[RANDOM_PROFILE_READ]) {
+        fprint_thread_stats(out, "Disk Random Read:", "IOPS", 1.0, &random_read_stats[RANDOM_PROFILE_READ]);
+    }
+    if (run_random_profile[RANDOM_PROFILE_WRITE]) {
+        fprint_thread_stats(out, "Disk Random Write:", "IOPS", 1.0, &random_write_stats[RANDOM_PROFILE_WRITE]);
+    }
+    if (run_direct_io) {
+        fprint_thread_stats(out, "O_DIRECT Read:", "MB/s", 1.0, &global_thread_stats.direct_read_throughput);
+        fprint_thread_stats(out, "O_DIRECT Write:", "MB/s", 1.0, &global_thread_stats.direct_write_throughput);
+    }
+}
+
+/* True when at least one random I/O profile was requested */
+bool any_random_profile(void) {
+    for (int p = 0; p < RANDOM_NUM_PROFILES; p++) {
+        if (run_random_profile[p]) return true;
+    }
+    return false;
+}
+
+/* True when at least one extended (unscored) test was requested */
+bool any_extended_test(void) {
+    return run_peak_flops || run_vector_math || run_dgemm || run_stream || run_latency ||
+           run_cache_sweep || run_numa || run_page_sizes || run_direct_io || run_uring ||
+           any_random_profile() || run_commit || run_mmap ||
+           run_io_sweep;
+}
+
+/* Extended-test CSV columns; always emitted so the schema is stable */
+void fprint_extended_csv_header(FILE* out) {
+    fprintf(out, ",PeakGFLOPS,VectorMathMFLOPS,VectorMathMaxULP");
+    fprintf(out, ",StreamCopyGBs,StreamScaleGBs,StreamAddGBs,StreamTriadGBs,StreamValid");
+    fprintf(out, ",DirectReadMBs,DirectWriteMBs,RandomReadIOPS,RandomWriteIOPS,MixedIOPS");
+    for (int s = 0; s < DGEMM_NUM_SIZES; s++) {
+        fprintf(out, ",DGEMM%dGFLOPS", dgemm_sizes[s]);
+    }
+}
+
+/* Extended-test CSV values, 0 for tests that were not run */
+void fprint_extended_csv_values(FILE* out) {
+    fprintf(out, ",%.2f", global_results.cpu_peak_flops / BILLION);
+    fprintf(out, ",%.2f,%.2f", global_results.cpu_vector_flops / 1000000.0, vector_math_max_ulp);
+    fprintf(out, ",%.2f,%.2f,%.2f,%.2f",
+            global_results.stream_copy_bandwidth / 1024.0, global_results.stream_scale_bandwidth / 1024.0,
+            global_results.stream_add_bandwidth / 1024.0, global_results.stream_triad_bandwidth / 1024.0);
+    fprintf(out, ",%d", stream_verified ? 1 : 0);
+    fprintf(out, ",%.2f,%.2f", global_results.direct_read_throughput, global_results.direct_write_throughput);
+    fprintf(out, ",%.2f,%.2f,%.2f", random_read_stats[RANDOM_PROFILE_READ].sum,
+            random_write_stats[RANDOM_PROFILE_WRITE].sum,
+            random_read_stats[RANDOM_PROFILE_MIXED].sum + random_write_stats[RANDOM_PROFILE_MIXED].sum);
+    for (int s = 0; s < DGEMM_NUM_SIZES; s++) {
+        fprintf(out, ",%.2f", dgemm_stats[s].sum / BILLION);
+    }
+}
+
+/* Write the bandwidth-vs-size curve, the plateau of every cache level
+ * reported by sysfs, and the sizes where read bandwidth actually dropped */
+void fprint_cache_sweep(FILE* out) {
+    fprintf(out, "  Cache bandwidth sweep (per-thread buffer, summed over %d threads):\n", num_threads);
+    for (int s = 0; s < cache_sweep_num_sizes; s++) {
+        fprintf(out, "    %9zu KB: read %9.2f MB/s  write %9.2f MB/s\n", cache_sweep_sizes[s] / 1024,
+                cache_sweep_read_stats[s].sum, cache_sweep_write_stats[s].sum);
+    }
+    
+    // Each level's plateau: sizes above the previous level and within half of
+    // the per-thread share of its own capacity
+    size_t low = 0;
+    for (int c = 0; c < num_cache_levels; c++) {
+        size_t share = cache_share_per_thread(&cache_levels[c]);
+        fprintf(out, "    L%d plateau (%zu KB/thread): read %9.2f MB/s  write %9.2f MB/s\n",
+                cache_levels[c].level, share / 1024,
+                cache_sweep_plateau(cache_sweep_read_stats, low, share / 2),
+                cache_sweep_plateau(cache_sweep_write_stats, low, share / 2));
+        if (share > low) low = share;
+    }
+    fprintf(out, "    DRAM plateau:        read %9.2f MB/s  write %9.2f MB/s\n",
+            cache_sweep_plateau(cache_sweep_read_stats, 2 * low, (size_t)-1),
+            cache_sweep_plateau(cache_sweep_write_stats, 2 * low, (size_t)-1));
+    
+    // Boundaries seen in the data itself, independent of sysfs
+    double plateau = (cache_sweep_num_sizes > 0) ? cache_sweep_read_stats[0].sum : 0;
+    for (int s = 1; s < cache_sweep_num_sizes; s++) {
+        double bw = cache_sweep_read_stats[s].sum;
+        if (bw < plateau * CACHE_SWEEP_DROP_RATIO) {
+            fprintf(out, "    Detected read bandwidth drop between %zu KB and %zu KB (%.0f -> %.0f MB/s)\n",
+                    cache_sweep_sizes[s - 1] / 1024, cache_sweep_sizes[s] / 1024, plateau, bw);
+            plateau = bw;
+        } else if (bw > plateau) {
+            plateau = bw;
+        }
+    }
+}
+
+/* Write the node-to-node matrices: rows are the node the threads ran on,
+ * columns the node their memory was bound to; "-" for cells that could not
+ * be measured with bound memory */
+void fprint_numa_matrix(FILE* out) {
+    fprintf(out, "  NUMA matrix (%d nodes, %d threads per cell, rows = CPU node, columns = memory node):\n",
+            num_numa_nodes, num_threads);
+    const char* titles[3] = {"Read MB/s", "Write MB/s", "Latency ns"};
+    for (int table = 0; table < 3; table++) {
+        fprintf(out, "    %-12s", titles[table]);
+        for (int m = 0; m < num_numa_nodes; m++) {
+            char label[16];
+            snprintf(label, sizeof(label), "node %d", numa_nodes[m].id);
+            fprintf(out, " %12s", label);
+        }
+        fprintf(out, "\n");
+        for (int c = 0; c < num_numa_nodes; c++) {
+            fprintf(out, "    node %-7d", numa_nodes[c].id);
+            for (int m = 0; m < num_numa_nodes; m++) {
+                if (!numa_measured[c][m]) {
+                    fprintf(out, " %12s", "-");
+                } else if (table == 0) {
+                    fprintf(out, " %12.2f", numa_read_stats[c][m].sum);
+                } else if (table == 1) {
+                    fprintf(out, " %12.2f", numa_write_stats[c][m].sum);
+                } else {
+                    fprintf(out, " %12.2f", numa_latency_ns[c][m]);
+                }
+            }
+            fprintf(out, "\n");
+        }
+    }
+}
+
+/* Write the bandwidth and latency measured with each page backing */
+void fprint_page_sizes(FILE* out) {
+    fprintf(out, "  Page size comparison (%zu MB per thread, latency over %zu MB):\n",
+            memory_block_size / (1024 * 1024), detect_llc_size() * LATENCY_LLC_MULTIPLE / (1024 * 1024));
+    for (int b = 0; b < PAGE_BACKING_COUNT; b++) {
+        if (!pages_available[b]) {
+            fprintf(out, "    %-8s unavailable\n", page_backing_names[b]);
+            continue;
+        }
+        fprintf(out, "    %-8s read %9.2f MB/s  write %9.2f MB/s  latency %7.2f ns  (%3.0f%% huge pages)\n",
+                page_backing_names[b], pages_read_stats[b].sum, pages_write_stats[b].sum,
+                pages_latency_ns[b], 100.0 * pages_huge_fraction[b]);
+    }
+}
+
+/* Write the percentiles of a histogram on one line, values divided by `scale` */
+void fprint_percentiles(FILE* out, const latency_histogram_t* h, double scale, const char* unit) {
+    if (h->count == 0) {
+        fprintf(out, "(no samples)\n");
+        return;
+    }
+    fprintf(out, "(%s:", unit);
+    for (int i = 0; i < HISTOGRAM_NUM_PERCENTILES; i++) {
+        fprintf(out, " p%g %.2f", histogram_percentiles[i], histogram_percentile(h, histogram_percentiles[i]) / scale);
+    }
+    fprintf(out, " max %.2f, %llu samples)\n", h->max / scale, (unsigned long long)h->count);
+}
+
+/* One row of benchmark_percentiles.csv */
+void fprint_percentiles_csv(FILE* out, const char* test, const char* operation,
+                            const latency_histogram_t* h, double scale, const char* unit) {
+    if (h->count == 0) return;
+    fprintf(out, "%s,%s,%s,%llu,%.3f", test, operation, unit, (unsigned long long)h->count,
+            h->sum / h->count / scale);
+    for (int i = 0; i < HISTOGRAM_NUM_PERCENTILES; i++) {
+        fprintf(out, ",%.3f", histogram_percentile(h, histogram_percentiles[i]) / scale);
+    }
+    fprintf(out, ",%.3f\n", h->max / scale);
+}
+
+/* Write the random I/O profiles that were run (not scored) */
+void fprint_random_profiles(FILE* out) {
+    char sync[48] = "no sync";
+    if (random_sync_mode == SYNC_DSYNC) {
+        snprintf(sync, sizeof(sync), "O_DSYNC");
+    } else if (random_sync_mode == SYNC_FDATASYNC) {
+        snprintf(sync, sizeof(sync), "fdatasync every %lld writes", random_sync_every);
+    }
+    fprintf(out, "  Random I/O (%zu KB requests, large preallocated file, %s, not scored):\n",
+            random_block_size / 1024, sync);
+    for (int p = 0; p < RANDOM_NUM_PROFILES; p++) {
+        if (!run_random_profile[p]) continue;
+        if (random_read_stats[p].count == 0) {
+            fprintf(out, "    %-6s no result\n", random_profile_names[p]);
+            continue;
+        }
+        double reads = random_read_stats[p].sum, writes = random_write_stats[p].sum;
+        fprintf(out, "    %-6s %10.2f IOPS (%.2f reads/s, %.2f writes/s", random_profile_names[p],
+                reads + writes, reads, writes);
+        if (p == RANDOM_PROFILE_MIXED) fprintf(out, ", %d%% reads requested", random_read_percent);
+        fprintf(out, ")\n");
+        const latency_histogram_t* histograms[3] = {&random_read_latency[p], &random_write_latency[p],
+                                                    &random_sync_latency[p]};
+        const char* const names[3] = {"pread", "pwrite", "fdatasync"};
+        for (int o = 0; o < 3; o++) {
+            if (histograms[o]->count == 0) continue;
+            fprintf(out, "      %-10s", names[o]);
+            fprint_percentiles(out, histograms[o], 1000.0, "us");
+        }
+    }
+}
+
+/* Write the I/O sweep as one IOPS table per engine: block sizes down,
+ * queue depths across */
+void fprint_io_sweep(FILE* out) {
+    fprintf(out, "  I/O sweep (random reads, IOPS summed over %d threads; latency in benchmark_io_sweep.csv):\n",
+            num_threads);
+    for (int e = 0; e < IO_NUM_ENGINES; e++) {
+        fprintf(out, "    %-9s", io_engine_names[e]);
+        for (int q = 0; q < IO_SWEEP_NUM_DEPTHS; q++) {
+            char label[16];
+            snprintf(label, sizeof(label), "QD%d", io_sweep_depths[q]);
+            fprintf(out, " %9s", label);
+        }
+        fprintf(out, "\n");
+        for (int b = 0; b < IO_SWEEP_NUM_BLOCKS; b++) {
+            fprintf(out, "    %5zu KB ", io_sweep_blocks[b] / 1024);
+            for (int q = 0; q < IO_SWEEP_NUM_DEPTHS; q++) {
+                const io_sweep_cell_t* cell = &io_sweep_cells[e][b][q];
+                if (cell->measured) {
+                    fprintf(out, " %9.0f", cell->iops.sum);
+                } else {
+                    fprintf(out, " %9s", "-");
+                }
+            }
+            fprintf(out, "\n");
+        }
+    }
+}
+
+/* Write the memory-mapped vs. system-call file I/O comparison */
+void fprint_mmap_results(FILE* out) {
+    fprintf(out, "  Memory-mapped file I/O (%zu MB file per thread, %zu KB sequential / %zu KB random,\n"
+                 "  cold page cache, summed over %d threads):\n",
+            file_size / (1024 * 1024), io_block_size / 1024, random_block_size / 1024, num_threads);
+    for (int w = 0; w < MMAP_NUM_WORKLOADS; w++) {
+        for (int m = 0; m < MMAP_NUM_PATHS; m++) {
+            if (mmap_throughput_stats[w][m].count == 0) {
+                fprintf(out, "    %-9s %-13s unavailable\n", mmap_workload_names[w], mmap_path_names[m]);
+                continue;
+            }
+            fprintf(out, "    %-9s %-13s %10.2f MB/s  page faults: %.0f minor, %.0f major\n",
+                    mmap_workload_names[w], mmap_path_names[m], mmap_throughput_stats[w][m].sum,
+                    mmap_minor_fault_stats[w][m].sum, mmap_major_fault_stats[w][m].sum);
+        }
+    }
+}
+
+/* Write commit rates and latencies per record size and sync grouping */
+void fprint_commit_results(FILE* out) {
+    fprintf(out, "  Commit latency (appended records + fdatasync, summed over %d threads):\n", num_threads);
+    for (int s = 0; s < COMMIT_NUM_SIZES; s++) {
+        for (int v = 0; v < COMMIT_NUM_VARIANTS; v++) {
+            int group = (v == 0) ? 1 : commit_group_size;
+            if (commit_stats[s][v].count == 0) {
+                fprintf(out, "    %6zu B x%-3d unavailable\n", commit_record_sizes[s], group);
+                continue;
+            }
+            fprintf(out, "    %6zu B x%-3d %10.2f commits/s %10.2f records/s ", commit_record_sizes[s], group,
+                    commit_stats[s][v].sum, commit_stats[s][v].sum * group);
+            fprint_percentiles(out, &commit_latency[s][v], 1000.0, "us");
+        }
+    }
+}
+
+/* Write the io_uring workload x queue depth matrix */
+void fprint_uring_matrix(FILE* out) {
+    fprintf(out, "  io_uring (%zu KB sequential / %zu KB random requests, summed over %d threads%s%s):\n",
+            io_block_size / 1024, random_block_size / 1024, num_threads,
+            uring_sqpoll ? ", SQPOLL" : "", uring_fixed ? ", registered buffers/files" : "");
+    for (int w = 0; w < URING_NUM_WORKLOADS; w++) {
+        for (int q = 0; q < uring_num_queue_depths; q++) {
+            if (uring_iops_stats[w][q].count == 0) {
+                fprintf(out, "    %-10s QD%-4d unavailable\n", uring_workload_names[w], uring_queue_depths[q]);
+                continue;
+            }
+            fprintf(out, "    %-10s QD%-4d %10.2f MB/s %12.0f IOPS\n", uring_workload_names[w],
+                    uring_queue_depths[q], uring_throughput_stats[w][q].sum, uring_iops_stats[w][q].sum);
+        }
+    }
+}
+
+/* Write the results of the extended (unscored) tests that were run */
+void fprint_extended_results(FILE* out) {
+    if (run_peak_flops) {
+        fprintf(out, "  Peak FLOPS (%s FMA chains): %.2f GFLOPS\n",
+                select_peak_flops_impl().name, global_results.cpu_peak_flops / BILLION);
+    }
+    if (run_vector_math) {
+        double speedup = (global_results.cpu_flops > 0)
+                             ? global_results.cpu_vector_flops / global_results.cpu_flops : 0;
+        fprintf(out, "  Vector Math (%s): %.2f MFLOPS (%.2fx scalar libm)%s\n",
+                select_vector_transcendental_impl().name, global_results.cpu_vector_flops / 1000000.0,
+                speedup, vector_math_verified ? "" : " [INVALID: ULP bound exceeded]");
+        fprintf(out, "    sin/cos max error %.2f ULP, checksum diff vs scalar %.2e\n",
+                vector_math_max_ulp, vector_math_checksum_diff);
+    }
+    if (run_stream) {
+        const double stream_bw[STREAM_NUM_KERNELS] = {
+            global_results.stream_copy_bandwidth, global_results.stream_scale_bandwidth,
+            global_results.stream_add_bandwidth, global_results.stream_triad_bandwidth};
+        fprintf(out, "  STREAM (%zu MB per array per thread)%s:\n", memory_block_size / (3 * 1024 * 1024),
+                stream_verified ? "" : " [INVALID: validation failed]");
+        for (int k = 0; k < STREAM_NUM_KERNELS; k++) {
+            fprintf(out, "    %-6s %8.2f GB/s  (%8.2f GB/s incl. write-allocate)\n",
+                    stream_kernel_names[k], stream_bw[k] / 1024.0,
+                    stream_write_allocate_bandwidth((stream_kernel_t)k, stream_bw[k]) / 1024.0);
+        }
+    }
+    if (run_latency) {
+        fprintf(out, "  Memory latency (random pointer chase, percentiles over batches):\n");
+        for (int s = 0; s < latency_num_sizes; s++) {
+            fprintf(out, "    %9zu KB: %8.2f ns per load ", latency_sizes[s] / 1024, latency_stats[s].mean);
+            fprint_percentiles(out, &latency_histograms[s], 1000.0, "ns");
+        }
+    }
+    if (run_cache_sweep) {
+        fprint_cache_sweep(out);
+    }
+    if (run_numa && num_numa_nodes > 0) {
+        fprint_numa_matrix(out);
+    }
+    if (run_page_sizes) {
+        fprint_page_sizes(out);
+    }
+    if (run_io_sweep) {
+        fprint_io_sweep(out);
+    }
+    if (run_mmap) {
+        fprint_mmap_results(out);
+    }
+    if (run_commit) {
+        fprint_commit_results(out);
+    }
+    if (run_uring) {
+        fprint_uring_matrix(out);
+    }
+    if (run_dgemm) {
+        fprintf(out, "  DGEMM (%s micro-kernel)%s:\n", select_dgemm_impl().name,
+                dgemm_verified ? "" : " [INVALID: verification failed]");
+        for (int s = 0; s < DGEMM_NUM_SIZES; s++) {
+            double working_set = 3.0 * dgemm_sizes[s] * dgemm_sizes[s] * sizeof(double);
+            fprintf(out, "    n=%-5d working set %9.1f KB: %8.2f GFLOPS (per-thread stddev %.2f)\n",
+                    dgemm_sizes[s], working_set / 1024.0, dgemm_stats[s].sum / BILLION,
+                    dgemm_stats[s].stddev / BILLION);
+        }
+    }
+}
+
 /* Print benchmark results with scores */
 void print_benchmark_results() {
     // Calculate scores before printing
@@ -535,6 +5134,20 @@ void print_benchmark_results() {
            global_results.memory_read_bandwidth);
     printf("║   Write Bandwidth                 ║ %7.2f MB ║ %9d ║\n", 
            global_results.memory_write_bandwidth, global_results.memory_score);
+    printf("║   Write Bandwidth (non-temporal)  ║ %7.2f MB ║           ║\n", 
+           global_results.memory_nt_write_bandwidth);
+    printf("║   Touch Bandwidth (strided)       ║ %7.2f MB ║           ║\n", 
+           global_results.memory_touch_bandwidth);
+    if (run_stream) {
+        printf("║   STREAM Copy                     ║ %7.2f GB ║           ║\n",
+               global_results.stream_copy_bandwidth / 1024.0);
+        printf("║   STREAM Scale                    ║ %7.2f GB ║           ║\n",
+               global_results.stream_scale_bandwidth / 1024.0);
+        printf("║   STREAM Add                      ║ %7.2f GB ║           ║\n",
+               global_results.stream_add_bandwidth / 1024.0);
+        printf("║   STREAM Triad                    ║ %7.2f GB ║           ║\n",
+               global_results.stream_triad_bandwidth / 1024.0);
+    }
     printf("╠═══════════════════════════════════╬═══════════╬═══════════╣\n");
     printf("║ Disk                              ║           ║           ║\n");
     printf("║   Sequential Read                 ║ %7.2f MB ║           ║\n", 
@@ -543,16 +5156,48 @@ void print_benchmark_results() {
            global_results.disk_write_throughput);
     printf("║   Random Access (IOPS)            ║ %7.2f    ║ %9d ║\n", 
            global_results.disk_seek_iops, global_results.disk_score);
+    if (run_random_profile[RANDOM_PROFILE_READ]) {
+        printf("║   Random Read (IOPS, large file)  ║ %7.0f    ║           ║\n",
+               random_read_stats[RANDOM_PROFILE_READ].sum);
+    }
+    if (run_random_profile[RANDOM_PROFILE_WRITE]) {
+        printf("║   Random Write (IOPS, large file) ║ %7.0f    ║           ║\n",
+               random_write_stats[RANDOM_PROFILE_WRITE].sum);
+    }
+    if (run_random_profile[RANDOM_PROFILE_MIXED]) {
+        printf("║   Mixed Random R/W (IOPS)         ║ %7.0f    ║           ║\n",
+               random_read_stats[RANDOM_PROFILE_MIXED].sum + random_write_stats[RANDOM_PROFILE_MIXED].sum);
+    }
+    if (run_direct_io) {
+        printf("║   Sequential Read (O_DIRECT)      ║ %7.2f MB ║           ║\n",
+               global_results.direct_read_throughput);
+        printf("║   Sequential Write (O_DIRECT)     ║ %7.2f MB ║           ║\n",
+               global_results.direct_write_throughput);
+    }
     printf("╚═══════════════════════════════════╩═══════════╩═══════════╝\n");
     printf("\n");
     
+    printf("Per-thread distribution (scores use the summed value):\n");
+    fprint_all_thread_stats(stdout);
+    printf("\n");
+    
+    if (any_extended_test()) {
+        printf("Extended results (not scored):\n");
+        fprint_extended_results(stdout);
+        printf("\n");
+    }
+    
     // Save results to file
     FILE* result_file = fopen("benchmark_results.txt", "w");
     if (result_file) {
         fprintf(result_file, "Benchmark Results\n");
         fprintf(result_file, "=================\n");
         fprintf(result_file, "System: %s\n", hostname);
-        fprintf(result_file, "Date: %s\n\n", timestamp);
+        fprintf(result_file, "Date: %s\n", timestamp);
+        char timer_text[128];
+        timer_describe(timer_text, sizeof(timer_text));
+        fprintf(result_file, "Affinity: %s\n", affinity_policy_names[affinity_policy]);
+        fprintf(result_file, "Timer: %s\n\n", timer_text);
         fprintf(result_file, "Overall Score: %d\n\n", global_results.overall_score);
         
         fprintf(result_file, "CPU Benchmark:\n");
@@ -562,13 +5207,48 @@ void print_benchmark_results() {
         fprintf(result_file, "Memory Benchmark:\n");
         fprintf(result_file, "  Read Bandwidth: %.2f MB/s\n", global_results.memory_read_bandwidth);
         fprintf(result_file, "  Write Bandwidth: %.2f MB/s\n", global_results.memory_write_bandwidth);
+        fprintf(result_file, "  Non-temporal Write Bandwidth (%s streaming stores, not scored): %.2f MB/s\n",
+                select_memory_nt_write_impl().name, global_results.memory_nt_write_bandwidth);
+        fprintf(result_file, "  Touch Bandwidth (128 B stride, not scored): %.2f MB/s\n",
+                global_results.memory_touch_bandwidth);
+        fprintf(result_file, "  Page Backing: %s (requested %s)\n",
+                page_backing_names[memory_page_backing_used], page_backing_names[memory_page_backing]);
         fprintf(result_file, "  Score: %d\n\n", global_results.memory_score);
         
         fprintf(result_file, "Disk Benchmark:\n");
         fprintf(result_file, "  Read Throughput: %.2f MB/s\n", global_results.disk_read_throughput);
         fprintf(result_file, "  Write Throughput: %.2f MB/s\n", global_results.disk_write_throughput);
         fprintf(result_file, "  Random Access: %.2f IOPS\n", global_results.disk_seek_iops);
-        fprintf(result_file, "  Score: %d\n", global_results.disk_score);
+        if (any_random_profile()) {
+            fprint_random_profiles(result_file);
+        }
+        if (run_direct_io) {
+            fprintf(result_file, "  O_DIRECT Read Throughput (%zu KB requests, not scored): %.2f MB/s\n",
+                    io_block_size / 1024, global_results.direct_read_throughput);
+            fprintf(result_file, "  O_DIRECT Write Throughput (fdatasync per pass, not scored): %.2f MB/s\n",
+                    global_results.direct_write_throughput);
+        }
+        fprintf(result_file, "  Score: %d\n\n", global_results.disk_score);
+        
+        fprintf(result_file, "Per-thread Distribution:\n");
+        fprint_all_thread_stats(result_file);
+        
+        if (any_extended_test()) {
+            fprintf(result_file, "\nExtended Results (not scored):\n");
+            fprint_extended_results(result_file);
+        }
+        
+        if (num_trials > 1) {
+            fprintf(result_file, "\nTrials (%d warmup run%s discarded, target CV %.2f%%, scored value = mean):\n",
+                    trial_warmup, trial_warmup == 1 ? "" : "s", trial_cv_target);
+            fprint_trials(result_file);
+        }
+        
+        if (run_perf) {
+            fprintf(result_file, "\nHardware Counters (%s, summed over each phase's threads):\n",
+                    perf_user_only ? "user space" : "user and kernel");
+            fprint_perf_phases(result_file);
+        }
         
         fclose(result_file);
         printf("Detailed results saved to benchmark_results.txt\n\n");
@@ -577,16 +5257,204 @@ void print_benchmark_results() {
     // Also save in CSV format for analysis
     result_file = fopen("benchmark_results.csv", "w");
     if (result_file) {
-        fprintf(result_file, "System,Date,OverallScore,CPUScore,MFLOPS,MemoryScore,ReadBandwidth,WriteBandwidth,DiskScore,ReadThroughput,WriteThroughput,IOPS\n");
-        fprintf(result_file, "%s,%s,%d,%d,%.2f,%d,%.2f,%.2f,%d,%.2f,%.2f,%.2f\n",
+        fprintf(result_file, "System,Date,OverallScore,CPUScore,MFLOPS,MemoryScore,ReadBandwidth,WriteBandwidth,DiskScore,ReadThroughput,WriteThroughput,IOPS,TouchBandwidth,NTWriteBandwidth");
+        fprint_extended_csv_header(result_file);
+        fprintf(result_file, "\n");
+        fprintf(result_file, "%s,%s,%d,%d,%.2f,%d,%.2f,%.2f,%d,%.2f,%.2f,%.2f,%.2f,%.2f",
                 hostname, timestamp, 
                 global_results.overall_score, 
                 global_results.cpu_score, global_results.cpu_flops / 1000000.0,
                 global_results.memory_score, global_results.memory_read_bandwidth, global_results.memory_write_bandwidth,
-                global_results.disk_score, global_results.disk_read_throughput, global_results.disk_write_throughput, global_results.disk_seek_iops);
+                global_results.disk_score, global_results.disk_read_throughput, global_results.disk_write_throughput, global_results.disk_seek_iops,
+                global_results.memory_touch_bandwidth, global_results.memory_nt_write_bandwidth);
+        fprint_extended_csv_values(result_file);
+        fprintf(result_file, "\n");
         fclose(result_file);
         printf("CSV results saved to benchmark_results.csv\n");
     }
+    
+    if (run_cache_sweep) {
+        result_file = fopen("benchmark_cache_sweep.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "BufferBytes,ReadMBs,WriteMBs\n");
+            for (int s = 0; s < cache_sweep_num_sizes; s++) {
+                fprintf(result_file, "%zu,%.2f,%.2f\n", cache_sweep_sizes[s],
+                        cache_sweep_read_stats[s].sum, cache_sweep_write_stats[s].sum);
+            }
+            fclose(result_file);
+            printf("Cache sweep saved to benchmark_cache_sweep.csv\n");
+        }
+    }
+    
+    if (run_numa && num_numa_nodes > 0) {
+        result_file = fopen("benchmark_numa.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "CPUNode,MemoryNode,ReadMBs,WriteMBs,LatencyNs\n");
+            for (int c = 0; c < num_numa_nodes; c++) {
+                if (numa_nodes[c].cpu_count == 0) continue;
+                for (int m = 0; m < num_numa_nodes; m++) {
+                    if (!numa_measured[c][m]) continue;
+                    fprintf(result_file, "%d,%d,%.2f,%.2f,%.3f\n", numa_nodes[c].id, numa_nodes[m].id,
+                            numa_read_stats[c][m].sum, numa_write_stats[c][m].sum, numa_latency_ns[c][m]);
+                }
+            }
+            fclose(result_file);
+            printf("NUMA matrix saved to benchmark_numa.csv\n");
+        }
+    }
+    
+    if (run_uring) {
+        result_file = fopen("benchmark_uring.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Workload,QueueDepth,BlockBytes,Threads,MBs,IOPS\n");
+            for (int w = 0; w < URING_NUM_WORKLOADS; w++) {
+                bool random = (w == URING_RAND_READ || w == URING_RAND_WRITE);
+                for (int q = 0; q < uring_num_queue_depths; q++) {
+                    fprintf(result_file, "%s,%d,%zu,%d,%.2f,%.0f\n", uring_workload_names[w],
+                            uring_queue_depths[q], random ? random_block_size : io_block_size,
+                            uring_iops_stats[w][q].count, uring_throughput_stats[w][q].sum,
+                            uring_iops_stats[w][q].sum);
+                }
+            }
+            fclose(result_file);
+            printf("io_uring matrix saved to benchmark_uring.csv\n");
+        }
+    }
+    
+    if (run_page_sizes) {
+        result_file = fopen("benchmark_pages.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Backing,Available,HugeFraction,ReadMBs,WriteMBs,LatencyNs\n");
+            for (int b = 0; b < PAGE_BACKING_COUNT; b++) {
+                fprintf(result_file, "%s,%d,%.3f,%.2f,%.2f,%.3f\n", page_backing_names[b],
+                        pages_available[b] ? 1 : 0, pages_huge_fraction[b], pages_read_stats[b].sum,
+                        pages_write_stats[b].sum, pages_latency_ns[b]);
+            }
+            fclose(result_file);
+            printf("Page size comparison saved to benchmark_pages.csv\n");
+        }
+    }
+    
+    if (num_trials > 1) {
+        result_file = fopen("benchmark_trials.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Metric,Unit,Trials,Rejected,Mean,Median,Stddev,CVPercent,CI95Low,CI95High");
+            int most = 0;
+            for (int m = 0; m < TRIAL_NUM_METRICS; m++) {
+                if (trial_metrics[m].count > most) most = trial_metrics[m].count;
+            }
+            for (int i = 1; i <= most; i++) fprintf(result_file, ",Trial%d", i);
+            fprintf(result_file, "\n");
+            for (int m = 0; m < TRIAL_NUM_METRICS; m++) {
+                const trial_metric_t* t = &trial_metrics[m];
+                if (t->count == 0) continue;
+                fprintf(result_file, "%s,%s,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f", t->name, t->unit, t->count,
+                        t->rejected, t->mean / t->scale, t->median / t->scale, t->stddev / t->scale, t->cv,
+                        t->ci_low / t->scale, t->ci_high / t->scale);
+                for (int i = 0; i < t->count; i++) fprintf(result_file, ",%.3f", t->samples[i] / t->scale);
+                fprintf(result_file, "\n");
+            }
+            fclose(result_file);
+            printf("Trial statistics saved to benchmark_trials.csv\n");
+        }
+    }
+    
+    if (run_io_sweep) {
+        result_file = fopen("benchmark_io_sweep.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Engine,Workload,BlockBytes,QueueDepth,IOPS,MBs,MeanLatencyUs,P50Us,P99Us,MaxUs\n");
+            for (int e = 0; e < IO_NUM_ENGINES; e++) {
+                for (int b = 0; b < IO_SWEEP_NUM_BLOCKS; b++) {
+                    for (int q = 0; q < IO_SWEEP_NUM_DEPTHS; q++) {
+                        const io_sweep_cell_t* cell = &io_sweep_cells[e][b][q];
+                        if (!cell->measured) continue;
+                        fprintf(result_file, "%s,rand-read,%zu,%d,%.2f,%.2f,%.3f,%.3f,%.3f,%.3f\n",
+                                io_engine_names[e], io_sweep_blocks[b], io_sweep_depths[q], cell->iops.sum,
+                                cell->throughput, cell->mean_us, cell->p50_us, cell->p99_us, cell->max_us);
+                    }
+                }
+            }
+            fclose(result_file);
+            printf("I/O sweep saved to benchmark_io_sweep.csv\n");
+        }
+    }
+    
+    if (run_mmap) {
+        result_file = fopen("benchmark_mmap.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Workload,Path,MBs,MinorFaults,MajorFaults\n");
+            for (int w = 0; w < MMAP_NUM_WORKLOADS; w++) {
+                for (int m = 0; m < MMAP_NUM_PATHS; m++) {
+                    fprintf(result_file, "%s,%s,%.2f,%.0f,%.0f\n", mmap_workload_names[w], mmap_path_names[m],
+                            mmap_throughput_stats[w][m].sum, mmap_minor_fault_stats[w][m].sum,
+                            mmap_major_fault_stats[w][m].sum);
+                }
+            }
+            fclose(result_file);
+            printf("mmap comparison saved to benchmark_mmap.csv\n");
+        }
+    }
+    
+    if (run_commit) {
+        result_file = fopen("benchmark_commit.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "RecordBytes,RecordsPerSync,CommitsPerSec,RecordsPerSec,MBs,P50Us,P99Us,MaxUs\n");
+            for (int s = 0; s < COMMIT_NUM_SIZES; s++) {
+                for (int v = 0; v < COMMIT_NUM_VARIANTS; v++) {
+                    int group = (v == 0) ? 1 : commit_group_size;
+                    double records = commit_stats[s][v].sum * group;
+                    fprintf(result_file, "%zu,%d,%.2f,%.2f,%.2f,%.3f,%.3f,%.3f\n", commit_record_sizes[s], group,
+                            commit_stats[s][v].sum, records, records * commit_record_sizes[s] / (1024 * 1024),
+                            histogram_percentile(&commit_latency[s][v], 50.0) / 1000.0,
+                            histogram_percentile(&commit_latency[s][v], 99.0) / 1000.0,
+                            commit_latency[s][v].max / 1000.0);
+                }
+            }
+            fclose(result_file);
+            printf("Commit latency saved to benchmark_commit.csv\n");
+        }
+    }
+    
+    if (run_latency || any_random_profile() || run_commit) {
+        result_file = fopen("benchmark_percentiles.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "Test,Operation,Unit,Samples,Mean,P50,P90,P99,P99.9,Max\n");
+            for (int p = 0; p < RANDOM_NUM_PROFILES; p++) {
+                char test[32];
+                snprintf(test, sizeof(test), "random %s", random_profile_names[p]);
+                fprint_percentiles_csv(result_file, test, "pread", &random_read_latency[p], 1000.0, "us");
+                fprint_percentiles_csv(result_file, test, "pwrite", &random_write_latency[p], 1000.0, "us");
+                fprint_percentiles_csv(result_file, test, "fdatasync", &random_sync_latency[p], 1000.0, "us");
+            }
+            for (int s = 0; s < COMMIT_NUM_SIZES; s++) {
+                for (int v = 0; v < COMMIT_NUM_VARIANTS; v++) {
+                    char test[48];
+                    snprintf(test, sizeof(test), "commit %zu B x%d", commit_record_sizes[s],
+                             (v == 0) ? 1 : commit_group_size);
+                    fprint_percentiles_csv(result_file, test, "commit", &commit_latency[s][v], 1000.0, "us");
+                }
+            }
+            for (int s = 0; s < latency_num_sizes; s++) {
+                char test[48];
+                snprintf(test, sizeof(test), "pointer chase %zu KB", latency_sizes[s] / 1024);
+                fprint_percentiles_csv(result_file, test, "load", &latency_histograms[s], 1000.0, "ns");
+            }
+            fclose(result_file);
+            printf("Latency percentiles saved to benchmark_percentiles.csv\n");
+        }
+    }
+    
+    if (run_latency) {
+        result_file = fopen("benchmark_latency.csv", "w");
+        if (result_file) {
+            fprintf(result_file, "WorkingSetBytes,LatencyNs\n");
+            for (int s = 0; s < latency_num_sizes; s++) {
+                fprintf(result_file, "%zu,%.3f\n", latency_sizes[s], latency_stats[s].mean);
+            }
+            fclose(result_file);
+            printf("Latency sweep saved to benchmark_latency.csv\n");
+        }
+    }
 }
 
 int main(int argc, char* argv[]) {
@@ -600,11 +5468,50 @@ int main(int argc, char* argv[]) {
     // Initialize random seed
     srand((unsigned int)time(NULL));
     
+    timer_init();
+    char timer_text[128];
+    timer_describe(timer_text, sizeof(timer_text));
+    
     log_message("Starting hardware performance benchmark with configuration:");
     log_message("  Threads per test: %d", num_threads);
     log_message("  Memory block size: %zu MB", memory_block_size / (1024 * 1024));
     log_message("  File size: %zu MB", file_size / (1024 * 1024));
+    if (run_direct_io || run_uring || any_random_profile()) {
+        log_message("  I/O block size: %zu KB sequential, %zu KB random",
+                    io_block_size / 1024, random_block_size / 1024);
+    }
     log_message("  Duration: %d seconds", duration);
+    log_message("  Timer: %s", timer_text);
+    if (run_perf) {
+        char perf_text[256];
+        perf_probe(perf_text, sizeof(perf_text));
+        log_message("  Perf counters: %s", perf_text);
+    }
+    if (load_profile == LOAD_PROFILE_CONTINUOUS) {
+        log_message("  Load profile: continuous (%d ms slices)", slice_ms);
+    } else {
+        log_message("  Load profile: bursty");
+    }
+    
+    if (affinity_policy != AFFINITY_NONE) {
+        if (plan_affinity(affinity_policy, affinity_cpu_list) == 0) {
+            log_message("  Affinity: %s unavailable (no usable CPUs); threads are not pinned",
+                        affinity_policy_names[affinity_policy]);
+            affinity_policy = AFFINITY_NONE;
+        } else {
+            char cpus[256] = "";
+            for (int k = 0; k < num_affinity_cpus && k < num_threads; k++) {
+                size_t used = strlen(cpus);
+                snprintf(cpus + used, sizeof(cpus) - used, "%s%d", k ? "," : "", affinity_cpus[k]);
+            }
+            log_message("  Affinity: %s, %d CPUs eligible, thread slots on CPUs %s%s",
+                        affinity_policy_names[affinity_policy], num_affinity_cpus, cpus,
+                        num_threads > num_affinity_cpus ? " (wrapping)" : "");
+            if (run_numa) {
+                log_message("  Affinity: --numa placement overrides the policy for memory threads");
+            }
+        }
+    }
     
     int total_threads = num_threads * 3;  // Threads for CPU, memory, and I/O tests
     pthread_t* threads = (pthread_t*)calloc(total_threads, sizeof(pthread_t));
@@ -651,57 +5558,345 @@ int main(int argc, char* argv[]) {
     
     // Run CPU benchmark
     log_message("╔═══ CPU BENCHMARK ═══╗");
-    for (int i = 0; i < num_threads; i++) {
-        if (pthread_create(&threads[i], NULL, cpu_benchmark, &args[i]) != 0) {
-            log_message("Failed to create CPU benchmark thread %d: %s", i, strerror(errno));
-            cleanup_resources(args, total_threads, threads);
-            return EXIT_FAILURE;
+    if (run_phase_trials(threads, args, 0, num_threads, cpu_benchmark, "CPU", aggregate_cpu_results,
+                         &trial_metrics[0], 1) < num_threads) {
+        cleanup_resources(args, total_threads, threads);
+        return EXIT_FAILURE;
+    }
+    log_message("╚═══════════════════╝");
+    
+    if (run_peak_flops) {
+        log_message("╔═══ CPU PEAK FLOPS BENCHMARK (%s) ═══╗", select_peak_flops_impl().name);
+        run_benchmark_phase(threads, args, 0, num_threads, cpu_peak_benchmark, "peak FLOPS");
+        aggregate_cpu_peak_results(args, 0, num_threads);
+        log_message("╚═══════════════════╝");
+    }
+    
+    if (run_vector_math) {
+        vector_transcendental_impl_t impl = select_vector_transcendental_impl();
+        log_message("╔═══ CPU VECTOR MATH BENCHMARK (%s) ═══╗", impl.name);
+        vector_math_verified = verify_vector_transcendental(impl, &vector_math_max_ulp,
+                                                            &vector_math_checksum_diff);
+        log_message("Vector sin/cos max error %.2f ULP (bound %.1f), checksum diff vs scalar %.2e",
+                    vector_math_max_ulp, TRANSCENDENTAL_ULP_BOUND, vector_math_checksum_diff);
+        if (!vector_math_verified) {
+            log_message("Vector math exceeds the ULP bound; its result is reported as invalid");
+        }
+        run_benchmark_phase(threads, args, 0, num_threads, cpu_vector_benchmark, "vector math");
+        aggregate_cpu_vector_results(args, 0, num_threads);
+        log_message("╚═══════════════════╝");
+    }
+    
+    if (run_dgemm) {
+        dgemm_impl_t impl = select_dgemm_impl();
+        log_message("╔═══ CPU DGEMM BENCHMARK (%s) ═══╗", impl.name);
+        dgemm_verified = verify_dgemm(&impl);
+        if (!dgemm_verified) {
+            log_message("DGEMM result mismatch against reference; results are reported as invalid");
+        }
+        for (int s = 0; s < DGEMM_NUM_SIZES && running; s++) {
+            if (!dgemm_problem_init(&dgemm_problem, dgemm_sizes[s])) {
+                log_message("Memory allocation failed for %dx%d DGEMM", dgemm_sizes[s], dgemm_sizes[s]);
+                dgemm_problem_free(&dgemm_problem);
+                continue;
+            }
+            run_benchmark_phase_for(threads, args, 0, num_threads, cpu_dgemm_benchmark, "DGEMM",
+                                    sweep_step_seconds(DGEMM_NUM_SIZES));
+            aggregate_dgemm_results(args, 0, num_threads, s);
+            dgemm_problem_free(&dgemm_problem);
+            log_message("DGEMM n=%-5d %8.2f GFLOPS", dgemm_sizes[s], dgemm_stats[s].sum / BILLION);
         }
+        log_message("╚═══════════════════╝");
     }
     
-    // Wait for CPU benchmark threads to complete
-    for (int i = 0; i < num_threads; i++) {
-        pthread_join(threads[i], NULL);
+    if (run_numa) {
+        if (read_numa_topology() == 0) {
+            log_message("No NUMA topology in /sys/devices/system/node; NUMA placement disabled");
+            run_numa = false;
+        }
+        for (int n = 0; n < num_numa_nodes; n++) {
+            log_message("NUMA node %d: %d CPUs", numa_nodes[n].id, numa_nodes[n].cpu_count);
+        }
     }
-    log_message("╚═══════════════════╝");
     
     // Run memory benchmark
     log_message("╔═══ MEMORY BENCHMARK ═══╗");
-    for (int i = 0; i < num_threads; i++) {
-        int idx = i + num_threads;
-        if (pthread_create(&threads[idx], NULL, memory_benchmark, &args[idx]) != 0) {
-            log_message("Failed to create memory benchmark thread %d: %s", i, strerror(errno));
-            running = false;
-            break;
+    run_phase_trials(threads, args, num_threads, num_threads, memory_benchmark, "memory",
+                     aggregate_memory_results, &trial_metrics[1], 2);
+    if (memory_page_backing_used != memory_page_backing) {
+        log_message("%s pages unavailable; memory buffers used %s pages",
+                    page_backing_names[memory_page_backing], page_backing_names[memory_page_backing_used]);
+    }
+    log_message("╚══════════════════════╝");
+    
+    if (run_latency) {
+        // Latency is measured unloaded, on the first memory thread only
+        log_message("╔═══ MEMORY LATENCY BENCHMARK ═══╗");
+        latency_plan_sizes(detect_llc_size());
+        for (int s = 0; s < latency_num_sizes && running; s++) {
+            latency_working_set = latency_sizes[s];
+            latency_histogram = &latency_histograms[s];
+            run_benchmark_phase_for(threads, args, num_threads, 1, memory_latency_benchmark,
+                                    "latency", sweep_step_seconds(latency_num_sizes));
+            reduce_thread_metric(args, num_threads, 1, offsetof(benchmark_result_t, memory_latency_ns),
+                                 &latency_stats[s]);
+            log_message("Latency %8zu KB: %7.2f ns", latency_sizes[s] / 1024, latency_stats[s].mean);
         }
+        latency_histogram = NULL;
+        log_message("╚══════════════════════╝");
     }
     
-    // Wait for memory benchmark threads to complete
-    for (int i = num_threads; i < 2 * num_threads; i++) {
-        if (threads[i]) {
-            pthread_join(threads[i], NULL);
+    if (run_cache_sweep) {
+        log_message("╔═══ CACHE BANDWIDTH SWEEP ═══╗");
+        read_cache_hierarchy();
+        for (int c = 0; c < num_cache_levels; c++) {
+            log_message("L%d %s cache: %zu KB, %d B lines, shared by %d CPUs", cache_levels[c].level,
+                        cache_levels[c].type, cache_levels[c].size / 1024, cache_levels[c].line_size,
+                        cache_levels[c].shared_cpus);
         }
+        cache_sweep_plan_sizes(detect_llc_size());
+        for (int s = 0; s < cache_sweep_num_sizes && running; s++) {
+            cache_sweep_size = cache_sweep_sizes[s];
+            run_benchmark_phase_for(threads, args, num_threads, num_threads, memory_sweep_benchmark,
+                                    "cache sweep", sweep_step_seconds(cache_sweep_num_sizes));
+            reduce_thread_metric(args, num_threads, num_threads,
+                                 offsetof(benchmark_result_t, sweep_read_bandwidth), &cache_sweep_read_stats[s]);
+            reduce_thread_metric(args, num_threads, num_threads,
+                                 offsetof(benchmark_result_t, sweep_write_bandwidth), &cache_sweep_write_stats[s]);
+            log_message("Sweep %8zu KB: read %9.2f MB/s, write %9.2f MB/s", cache_sweep_sizes[s] / 1024,
+                        cache_sweep_read_stats[s].sum, cache_sweep_write_stats[s].sum);
+        }
+        log_message("╚══════════════════════╝");
+    }
+    
+    if (run_numa) {
+        log_message("╔═══ NUMA MATRIX BENCHMARK ═══╗");
+        bool bound = false;
+        void* probe = numa_alloc_on_node(getpagesize(), &numa_nodes[0], &bound);
+        int bind_errno = errno;
+        if (probe) munmap(probe, getpagesize());
+        if (!bound) {
+            log_message("mbind() refused (%s); cells without bound memory are left out", strerror(bind_errno));
+        }
+        int cells = num_numa_nodes * num_numa_nodes;
+        for (int c = 0; c < num_numa_nodes && running; c++) {
+            if (numa_nodes[c].cpu_count == 0) continue;
+            for (int m = 0; m < num_numa_nodes && running; m++) {
+                numa_cpu_node = c;
+                numa_mem_node = m;
+                run_benchmark_phase_for(threads, args, num_threads, num_threads, memory_numa_benchmark,
+                                        "NUMA", sweep_step_seconds(2 * cells));
+                reduce_thread_metric(args, num_threads, num_threads,
+                                     offsetof(benchmark_result_t, numa_read_bandwidth), &numa_read_stats[c][m]);
+                reduce_thread_metric(args, num_threads, num_threads,
+                                     offsetof(benchmark_result_t, numa_write_bandwidth), &numa_write_stats[c][m]);
+                
+                thread_stats_t latency;
+                run_benchmark_phase_for(threads, args, num_threads, 1, memory_numa_latency_benchmark,
+                                        "NUMA latency", sweep_step_seconds(2 * cells));
+                reduce_thread_metric(args, num_threads, 1, offsetof(benchmark_result_t, numa_latency_ns), &latency);
+                numa_latency_ns[c][m] = latency.mean;
+                numa_measured[c][m] = numa_read_stats[c][m].count > 0 && latency.count > 0;
+                if (!numa_measured[c][m]) {
+                    log_message("NUMA node %d -> node %d: memory could not be bound; cell left out",
+                                numa_nodes[c].id, numa_nodes[m].id);
+                    continue;
+                }
+                log_message("NUMA node %d -> node %d: read %9.2f MB/s, write %9.2f MB/s, latency %7.2f ns",
+                            numa_nodes[c].id, numa_nodes[m].id, numa_read_stats[c][m].sum,
+                            numa_write_stats[c][m].sum, numa_latency_ns[c][m]);
+            }
+        }
+        log_message("╚══════════════════════╝");
+    }
+    
+    if (run_page_sizes) {
+        log_message("╔═══ PAGE SIZE COMPARISON ═══╗");
+        for (int b = 0; b < PAGE_BACKING_COUNT && running; b++) {
+            page_test_backing = (page_backing_t)b;
+            run_benchmark_phase_for(threads, args, num_threads, num_threads, memory_pages_benchmark,
+                                    "page size", sweep_step_seconds(2 * PAGE_BACKING_COUNT));
+            reduce_thread_metric(args, num_threads, num_threads,
+                                 offsetof(benchmark_result_t, pages_read_bandwidth), &pages_read_stats[b]);
+            reduce_thread_metric(args, num_threads, num_threads,
+                                 offsetof(benchmark_result_t, pages_write_bandwidth), &pages_write_stats[b]);
+            thread_stats_t fraction;
+            reduce_thread_metric(args, num_threads, num_threads,
+                                 offsetof(benchmark_result_t, pages_huge_fraction), &fraction);
+            pages_huge_fraction[b] = fraction.mean;
+            pages_available[b] = (pages_read_stats[b].count > 0);
+            if (!pages_available[b]) {
+                log_message("Pages %-7s unavailable", page_backing_names[b]);
+                continue;
+            }
+            
+            thread_stats_t latency;
+            run_benchmark_phase_for(threads, args, num_threads, 1, memory_pages_latency_benchmark,
+                                    "page size latency", sweep_step_seconds(2 * PAGE_BACKING_COUNT));
+            reduce_thread_metric(args, num_threads, 1, offsetof(benchmark_result_t, pages_latency_ns), &latency);
+            pages_latency_ns[b] = latency.mean;
+            log_message("Pages %-7s read %9.2f MB/s, write %9.2f MB/s, latency %7.2f ns, %3.0f%% huge",
+                        page_backing_names[b], pages_read_stats[b].sum, pages_write_stats[b].sum,
+                        pages_latency_ns[b], 100.0 * pages_huge_fraction[b]);
+        }
+        log_message("╚══════════════════════╝");
+    }
+    
+    if (run_stream) {
+        log_message("╔═══ MEMORY STREAM BENCHMARK ═══╗");
+        run_benchmark_phase(threads, args, num_threads, num_threads, memory_stream_benchmark, "STREAM");
+        aggregate_stream_results(args, num_threads, num_threads);
+        log_message("╚══════════════════════╝");
     }
-    log_message("╚══════════════════════╝");
     
     // Run I/O benchmark
     log_message("╔═══ DISK I/O BENCHMARK ═══╗");
-    for (int i = 0; i < num_threads; i++) {
-        int idx = i + 2 * num_threads;
-        if (pthread_create(&threads[idx], NULL, io_benchmark, &args[idx]) != 0) {
-            log_message("Failed to create I/O benchmark thread %d: %s", i, strerror(errno));
-            running = false;
-            break;
+    run_phase_trials(threads, args, 2 * num_threads, num_threads, io_benchmark, "I/O",
+                     aggregate_disk_results, &trial_metrics[3], 3);
+    log_message("╚═════════════════════════╝");
+    
+    if (run_direct_io) {
+        log_message("╔═══ DISK O_DIRECT BENCHMARK (%zu KB requests) ═══╗", io_block_size / 1024);
+        run_benchmark_phase(threads, args, 2 * num_threads, num_threads, io_direct_benchmark, "O_DIRECT");
+        aggregate_direct_results(args, 2 * num_threads, num_threads);
+        if (global_thread_stats.direct_read_throughput.count == 0) {
+            log_message("O_DIRECT is not available for the benchmark files; no result");
         }
+        log_message("╚═════════════════════════╝");
     }
     
-    // Wait for I/O benchmark threads to complete
-    for (int i = 2 * num_threads; i < total_threads; i++) {
-        if (threads[i]) {
-            pthread_join(threads[i], NULL);
+    if (any_random_profile()) {
+        log_message("╔═══ DISK RANDOM I/O BENCHMARK (%zu KB) ═══╗", random_block_size / 1024);
+        for (int p = 0; p < RANDOM_NUM_PROFILES && running; p++) {
+            if (!run_random_profile[p]) continue;
+            random_profile = (random_profile_t)p;
+            run_benchmark_phase(threads, args, 2 * num_threads, num_threads, io_random_benchmark, "random I/O");
+            aggregate_random_results(args, 2 * num_threads, num_threads, random_profile);
+            log_message("Random %-6s %10.2f reads/s %10.2f writes/s", random_profile_names[p],
+                        random_read_stats[p].sum, random_write_stats[p].sum);
+        }
+        for (int i = 2 * num_threads; i < total_threads; i++) {
+            char filename[96];
+            random_file_name(filename, sizeof(filename), &args[i]);
+            remove(filename);
         }
+        log_message("╚═════════════════════════╝");
+    }
+    
+    if (run_io_sweep) {
+        log_message("╔═══ DISK QUEUE DEPTH x BLOCK SIZE SWEEP ═══╗");
+        int cells = IO_SWEEP_NUM_BLOCKS * (1 + IO_SWEEP_NUM_DEPTHS);
+        for (int e = 0; e < IO_NUM_ENGINES && running; e++) {
+#ifndef HAVE_IO_URING
+            if (e == IO_ENGINE_URING) {
+                log_message("io_uring: not supported by this build");
+                continue;
+            }
+#endif
+            for (int b = 0; b < IO_SWEEP_NUM_BLOCKS && running; b++) {
+                int depths = (e == IO_ENGINE_PSYNC) ? 1 : IO_SWEEP_NUM_DEPTHS;
+                for (int q = 0; q < depths && running; q++) {
+                    io_sweep_cell_t* cell = &io_sweep_cells[e][b][q];
+                    io_sweep_engine = (io_engine_t)e;
+                    io_sweep_block = io_sweep_blocks[b];
+                    io_sweep_depth = io_sweep_depths[q];
+                    memset(&io_sweep_histogram, 0, sizeof(io_sweep_histogram));
+                    run_benchmark_phase_for(threads, args, 2 * num_threads, num_threads, io_sweep_benchmark,
+                                            "I/O sweep", sweep_step_seconds(cells));
+                    reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                         offsetof(benchmark_result_t, io_sweep_iops), &cell->iops);
+                    thread_stats_t throughput;
+                    reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                         offsetof(benchmark_result_t, io_sweep_throughput), &throughput);
+                    cell->measured = cell->iops.count > 0;
+                    cell->throughput = throughput.sum;
+                    if (io_sweep_histogram.count > 0) {
+                        cell->mean_us = io_sweep_histogram.sum / io_sweep_histogram.count / 1000.0;
+                        cell->p50_us = histogram_percentile(&io_sweep_histogram, 50.0) / 1000.0;
+                        cell->p99_us = histogram_percentile(&io_sweep_histogram, 99.0) / 1000.0;
+                        cell->max_us = io_sweep_histogram.max / 1000.0;
+                    }
+                    log_message("%-8s %5zu KB QD%-4d %10.0f IOPS %9.2f MB/s, p99 %.1f us", io_engine_names[e],
+                                io_sweep_block / 1024, io_sweep_depth, cell->iops.sum, cell->throughput,
+                                cell->p99_us);
+                }
+            }
+        }
+        for (int i = 2 * num_threads; i < total_threads; i++) {
+            char filename[96];
+            random_file_name(filename, sizeof(filename), &args[i]);
+            remove(filename);
+        }
+        log_message("╚═════════════════════════╝");
+    }
+    
+    if (run_mmap) {
+        log_message("╔═══ DISK MMAP BENCHMARK ═══╗");
+        int cells = MMAP_NUM_WORKLOADS * MMAP_NUM_PATHS;
+        for (int w = 0; w < MMAP_NUM_WORKLOADS && running; w++) {
+            for (int m = 0; m < MMAP_NUM_PATHS && running; m++) {
+                mmap_workload = (mmap_workload_t)w;
+                mmap_path = (mmap_path_t)m;
+                run_benchmark_phase_for(threads, args, 2 * num_threads, num_threads, io_mmap_benchmark,
+                                        "mmap", sweep_step_seconds(cells));
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, mmap_throughput), &mmap_throughput_stats[w][m]);
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, mmap_minor_faults), &mmap_minor_fault_stats[w][m]);
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, mmap_major_faults), &mmap_major_fault_stats[w][m]);
+                log_message("mmap %-9s %-13s %10.2f MB/s, %.0f minor / %.0f major faults", mmap_workload_names[w],
+                            mmap_path_names[m], mmap_throughput_stats[w][m].sum, mmap_minor_fault_stats[w][m].sum,
+                            mmap_major_fault_stats[w][m].sum);
+            }
+        }
+        for (int i = 2 * num_threads; i < total_threads; i++) {
+            char filename[96];
+            mmap_file_name(filename, sizeof(filename), &args[i]);
+            remove(filename);
+        }
+        log_message("╚═════════════════════════╝");
+    }
+    
+    if (run_commit) {
+        log_message("╔═══ DISK COMMIT LATENCY BENCHMARK ═══╗");
+        int cells = COMMIT_NUM_SIZES * COMMIT_NUM_VARIANTS;
+        for (int s = 0; s < COMMIT_NUM_SIZES && running; s++) {
+            for (int v = 0; v < COMMIT_NUM_VARIANTS && running; v++) {
+                commit_record_size = commit_record_sizes[s];
+                commit_group = (v == 0) ? 1 : commit_group_size;
+                commit_histogram = &commit_latency[s][v];
+                run_benchmark_phase_for(threads, args, 2 * num_threads, num_threads, io_commit_benchmark,
+                                        "commit", sweep_step_seconds(cells));
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, commit_rate), &commit_stats[s][v]);
+                log_message("Commit %6zu B x%-3d %10.2f commits/s, p99 %.2f us", commit_record_size, commit_group,
+                            commit_stats[s][v].sum, histogram_percentile(commit_histogram, 99.0) / 1000.0);
+            }
+        }
+        commit_histogram = NULL;
+        log_message("╚═════════════════════════╝");
+    }
+    
+    if (run_uring) {
+        log_message("╔═══ DISK IO_URING BENCHMARK ═══╗");
+        int cells = URING_NUM_WORKLOADS * uring_num_queue_depths;
+        for (int w = 0; w < URING_NUM_WORKLOADS && running; w++) {
+            for (int q = 0; q < uring_num_queue_depths && running; q++) {
+                uring_workload = (uring_workload_t)w;
+                uring_queue_depth = uring_queue_depths[q];
+                run_benchmark_phase_for(threads, args, 2 * num_threads, num_threads, io_uring_benchmark,
+                                        "io_uring", sweep_step_seconds(cells));
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, uring_throughput), &uring_throughput_stats[w][q]);
+                reduce_thread_metric(args, 2 * num_threads, num_threads,
+                                     offsetof(benchmark_result_t, uring_iops), &uring_iops_stats[w][q]);
+                log_message("io_uring %-10s QD%-4d %10.2f MB/s %12.0f IOPS", uring_workload_names[w],
+                            uring_queue_depth, uring_throughput_stats[w][q].sum, uring_iops_stats[w][q].sum);
+            }
+        }
+        log_message("╚═════════════════════════╝");
     }
-    log_message("╚═════════════════════════╝");
     
     log_message("All benchmarks completed");
     